@@ -0,0 +1,210 @@
+#include "BatchRenderer.hpp"
+#include "RenderCoordinator.hpp"
+#include "RenderWorker.hpp"
+
+#include "Engine/ThreadPlacement.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	void PrintUsage(const char* program)
+	{
+		printf("Usage: %s [OPTIONS] SCENE OUTPUT\n", program);
+		printf("       %s --coordinator PORT [OPTIONS] SCENE OUTPUT\n", program);
+		printf("       %s --worker HOST:PORT [OPTIONS] SCENE\n", program);
+		printf("\n");
+		printf("Options:\n");
+		printf("  --resolution WIDTHxHEIGHT             Output image resolution (default 1920x1080)\n");
+		printf("  --spp COUNT                           Samples per pixel (default from scene)\n");
+		printf("  --time-budget MILLISECONDS            Render progressively until the time budget expires (not with --coordinator)\n");
+		printf("  --threads COUNT                       Number of render threads (default all hardware threads)\n");
+		printf("  --affinity none|compact|scatter       Render thread CPU affinity (default none)\n");
+		printf("  --checkpoint PATH                     Periodically save the render's progress to the given file (not with --coordinator)\n");
+		printf("  --checkpoint-interval SECONDS         Time between checkpoints (default 300)\n");
+		printf("  --resume                              Continue from the checkpoint file, if it exists (not with --coordinator)\n");
+		printf("  --denoise                             Denoise the finished render (not with --coordinator)\n");
+		printf("  --aovs NAME[,NAME...]                 Also write depth|normal|albedo|object|material AOVs (not with --coordinator)\n");
+		printf("  --coordinator PORT                    Distribute tiles to workers connecting on the given port\n");
+		printf("  --worker HOST:PORT                    Render tiles for the coordinator at the given address\n");
+	}
+
+	std::optional<size_t> ParseNumber(const std::string& value)
+	{
+		size_t number = 0;
+
+		const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+		if (error != std::errc() || end != (value.data() + value.size()) || ! number)
+			return std::nullopt;
+
+		return number;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	BatchRenderer::Options options;
+	options.numRenderThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+	std::optional<uint16_t> coordinatorPort;
+	std::optional<std::pair<std::string, uint16_t>> workerCoordinator;
+
+	std::vector<std::string> positionalArguments;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string argument = argv[i];
+		const bool hasValue = (i + 1) < argc;
+
+		bool valid = true;
+
+		if (argument == "--resolution" && hasValue)
+		{
+			const std::string value = argv[++i];
+			const auto separator = value.find('x');
+
+			const auto width = ParseNumber(value.substr(0, separator));
+			const auto height = (separator != std::string::npos) ? ParseNumber(value.substr(separator + 1)) : std::nullopt;
+
+			valid = width && height;
+			options.width = width.value_or(0);
+			options.height = height.value_or(0);
+		}
+		else if (argument == "--spp" && hasValue)
+		{
+			const auto samplesPerPixel = ParseNumber(argv[++i]);
+
+			valid = samplesPerPixel.has_value();
+			options.samplesPerPixel = static_cast<uint32_t>(samplesPerPixel.value_or(1));
+		}
+		else if (argument == "--time-budget" && hasValue)
+		{
+			const auto timeBudget = ParseNumber(argv[++i]);
+
+			valid = timeBudget.has_value();
+			options.timeBudget = std::chrono::milliseconds(timeBudget.value_or(0));
+		}
+		else if (argument == "--threads" && hasValue)
+		{
+			const auto numRenderThreads = ParseNumber(argv[++i]);
+
+			valid = numRenderThreads.has_value();
+			options.numRenderThreads = numRenderThreads.value_or(0);
+		}
+		else if (argument == "--affinity" && hasValue)
+		{
+			const auto affinity = ThreadPlacement::ParseAffinity(argv[++i]);
+
+			valid = affinity.has_value();
+			options.affinity = affinity.value_or(ThreadAffinity::None);
+		}
+		else if (argument == "--checkpoint" && hasValue)
+		{
+			options.checkpointPath = argv[++i];
+		}
+		else if (argument == "--checkpoint-interval" && hasValue)
+		{
+			const auto checkpointInterval = ParseNumber(argv[++i]);
+
+			valid = checkpointInterval.has_value();
+			options.checkpointInterval = std::chrono::seconds(checkpointInterval.value_or(0));
+		}
+		else if (argument == "--resume")
+		{
+			options.resume = true;
+		}
+		else if (argument == "--denoise")
+		{
+			options.denoise = true;
+		}
+		else if (argument == "--aovs" && hasValue)
+		{
+			const std::string value = argv[++i];
+
+			for (size_t nameStart = 0; nameStart <= value.size();)
+			{
+				const size_t nameEnd = std::min(value.find(',', nameStart), value.size());
+				const auto aov = Renderer::ParseAov(value.substr(nameStart, nameEnd - nameStart));
+
+				valid = valid && aov.has_value();
+				if (aov && std::find(options.aovs.begin(), options.aovs.end(), *aov) == options.aovs.end())
+					options.aovs.push_back(*aov);
+
+				nameStart = nameEnd + 1;
+			}
+		}
+		else if (argument == "--coordinator" && hasValue)
+		{
+			const auto port = ParseNumber(argv[++i]).value_or(0);
+
+			valid = port && port <= std::numeric_limits<uint16_t>::max();
+			coordinatorPort = static_cast<uint16_t>(port);
+		}
+		else if (argument == "--worker" && hasValue)
+		{
+			const std::string value = argv[++i];
+			const auto separator = value.rfind(':');
+
+			const auto port = (separator != std::string::npos) ? ParseNumber(value.substr(separator + 1)).value_or(0) : 0;
+
+			valid = separator && port && port <= std::numeric_limits<uint16_t>::max();
+			workerCoordinator = { value.substr(0, separator), static_cast<uint16_t>(port) };
+		}
+		else if (! argument.starts_with("--"))
+		{
+			positionalArguments.push_back(argument);
+		}
+		else
+		{
+			valid = false;
+		}
+
+		if (! valid)
+		{
+			fprintf(stderr, "Invalid argument '%s'\n", argument.c_str());
+
+			PrintUsage(argv[0]);
+			return BatchRenderer::ExitCode::InvalidArguments;
+		}
+	}
+
+	// Workers only need the scene, as the coordinator writes the output image.
+	const size_t numPositionalArguments = workerCoordinator ? 1 : 2;
+
+	// The coordinator only hands out tiles, so it can't stop early, checkpoint or post-process the render.
+	const bool coordinatorUnsupported = options.timeBudget || options.checkpointPath || options.resume || options.denoise || ! options.aovs.empty();
+
+	if (positionalArguments.size() != numPositionalArguments || ! options.numRenderThreads || (coordinatorPort && workerCoordinator) || (options.resume && ! options.checkpointPath) || (coordinatorPort && coordinatorUnsupported))
+	{
+		PrintUsage(argv[0]);
+		return BatchRenderer::ExitCode::InvalidArguments;
+	}
+
+	options.scenePath = positionalArguments[0];
+
+	if (workerCoordinator)
+	{
+		RenderWorker renderWorker(options, workerCoordinator->first, workerCoordinator->second);
+		return renderWorker.run();
+	}
+
+	options.outputPath = positionalArguments[1];
+
+	if (coordinatorPort)
+	{
+		RenderCoordinator renderCoordinator(options, *coordinatorPort);
+		return renderCoordinator.run();
+	}
+
+	BatchRenderer batchRenderer(options);
+	return batchRenderer.render();
+}
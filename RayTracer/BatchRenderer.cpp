@@ -0,0 +1,270 @@
+#include "BatchRenderer.hpp"
+#include "SceneLoader.hpp"
+
+#include "Engine/Checkpoint.hpp"
+#include "Engine/Image.hpp"
+#include "Engine/Scene.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	constexpr auto kProgressUpdateInterval = std::chrono::milliseconds(250);
+	constexpr size_t kMinFrameNumberDigits = 4;
+}
+
+BatchRenderer::BatchRenderer(const Options& options)
+	: m_options(options)
+	, m_renderer(options.width, options.height, options.numRenderThreads, options.affinity)
+{
+
+}
+
+BatchRenderer::ExitCode BatchRenderer::render()
+{
+	SceneLoader sceneLoader;
+
+	Scene scene;
+
+	try
+	{
+		scene = sceneLoader.load(m_options.scenePath);
+	}
+	catch (const std::exception& e)
+	{
+		fprintf(stderr, "Failed to parse scene file: %s\n", e.what());
+		return ExitCode::SceneLoadFailed;
+	}
+
+	m_sceneHash = SceneLoader::HashFile(m_options.scenePath);
+
+	if (m_options.samplesPerPixel)
+		scene.samplesPerPixel = *m_options.samplesPerPixel;
+
+	printf("Rendering '%s' at %zux%zu, %u samples/pixel, %zu threads\n", m_options.scenePath.c_str(), m_options.width, m_options.height, scene.samplesPerPixel, m_options.numRenderThreads);
+	if (m_options.timeBudget)
+		printf("Time budget of %lld ms\n", static_cast<long long>(m_options.timeBudget->count()));
+
+	if (m_options.affinity != ThreadAffinity::None)
+		printf("%s", m_renderer.threadPlacement().report().c_str());
+
+	// The scene is loaded and its meshes partitioned once; each frame of a
+	// sequence only swaps the camera before tracing again.
+	const std::vector<Camera> sequence = std::move(scene.sequence);
+	if (! sequence.empty())
+		printf("Sequence of %zu frames\n", sequence.size());
+
+	m_renderer.setScene(std::move(scene));
+	m_renderer.setTimeBudget(m_options.timeBudget);
+
+	if (sequence.empty())
+		return renderFrame(m_options.outputPath, m_options.checkpointPath);
+
+	for (size_t frame = 0; frame < sequence.size(); frame++)
+	{
+		printf("Frame %zu/%zu\n", frame + 1, sequence.size());
+
+		const std::string outputPath = framePath(m_options.outputPath, frame, sequence.size());
+
+		// When resuming a sequence, frames that were already written are skipped.
+		if (m_options.resume && std::filesystem::exists(outputPath))
+		{
+			printf("Skipping frame, '%s' already exists\n", outputPath.c_str());
+			continue;
+		}
+
+		// Each frame has its own checkpoint, so a resumed frame can't pick up another frame's samples.
+		std::optional<std::string> checkpointPath;
+		if (m_options.checkpointPath)
+			checkpointPath = framePath(*m_options.checkpointPath, frame, sequence.size());
+
+		m_renderer.setCamera(sequence[frame]);
+
+		if (const auto exitCode = renderFrame(outputPath, checkpointPath); exitCode != ExitCode::Success)
+			return exitCode;
+	}
+
+	return ExitCode::Success;
+}
+
+BatchRenderer::ExitCode BatchRenderer::renderFrame(const std::string& outputPath, const std::optional<std::string>& checkpointPath)
+{
+	if (const auto exitCode = startOrResumeRender(checkpointPath); exitCode != ExitCode::Success)
+		return exitCode;
+
+	int lastRenderPercent = -1;
+	while (m_renderer.isRendering())
+	{
+		if (lastRenderPercent != m_renderer.renderPercentage())
+		{
+			lastRenderPercent = m_renderer.renderPercentage();
+
+			printf("\rRendering... %3d%%", lastRenderPercent);
+			fflush(stdout);
+		}
+
+		std::this_thread::sleep_for(kProgressUpdateInterval);
+	}
+
+	printf("\rRendering... 100%%\n");
+	printf("Render completed in %lld ms (%u samples/pixel)\n", static_cast<long long>(m_renderer.renderTime().count()), m_renderer.renderedSamplesPerPixel());
+
+	if (m_options.denoise)
+	{
+		const auto denoiseStartTime = std::chrono::steady_clock::now();
+		m_renderer.updatePixels(true);
+
+		printf("Denoised in %lld ms\n", static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - denoiseStartTime).count()));
+	}
+
+	if (! saveImage(outputPath))
+	{
+		fprintf(stderr, "Failed to save image to '%s'\n", outputPath.c_str());
+		return ExitCode::ImageSaveFailed;
+	}
+
+	printf("Saved image to '%s'\n", outputPath.c_str());
+
+	for (const auto aov : m_options.aovs)
+	{
+		const std::string path = aovPath(outputPath, aov);
+
+		if (! saveAov(path, aov))
+		{
+			fprintf(stderr, "Failed to save %s AOV to '%s'\n", Renderer::AovName(aov).c_str(), path.c_str());
+			return ExitCode::ImageSaveFailed;
+		}
+
+		printf("Saved %s AOV to '%s'\n", Renderer::AovName(aov).c_str(), path.c_str());
+	}
+
+	// The checkpoint is no longer needed once the finished image is safely on disk.
+	if (checkpointPath)
+	{
+		std::error_code error;
+		std::filesystem::remove(*checkpointPath, error);
+	}
+
+	return ExitCode::Success;
+}
+
+BatchRenderer::ExitCode BatchRenderer::startOrResumeRender(const std::optional<std::string>& checkpointPath)
+{
+	if (! checkpointPath)
+	{
+		m_renderer.setCheckpointing(std::nullopt);
+		m_renderer.startRender();
+
+		return ExitCode::Success;
+	}
+
+	m_renderer.setCheckpointing(Renderer::CheckpointSettings{ .path = *checkpointPath, .interval = m_options.checkpointInterval, .sceneHash = m_sceneHash });
+
+	if (! m_options.resume || ! std::filesystem::exists(*checkpointPath))
+	{
+		m_renderer.startRender();
+		return ExitCode::Success;
+	}
+
+	// A checkpoint that doesn't match is an error rather than a reason to start over,
+	// so that a mistyped command line can't silently throw away hours of rendering.
+	const auto checkpoint = Checkpoint::Load(*checkpointPath);
+	if (! checkpoint || checkpoint->sceneHash != m_sceneHash || ! m_renderer.resumeRender(*checkpoint))
+	{
+		fprintf(stderr, "Checkpoint '%s' is unreadable or doesn't match this scene and render settings\n", checkpointPath->c_str());
+		return ExitCode::CheckpointInvalid;
+	}
+
+	printf("Resuming from checkpoint '%s' after %u of %u samples/pixel\n", checkpointPath->c_str(), checkpoint->completedPasses * checkpoint->samplesPerPass, checkpoint->samplesPerPixel);
+	return ExitCode::Success;
+}
+
+std::string BatchRenderer::framePath(const std::string& pathPattern, size_t frame, size_t numFrames) const
+{
+	std::string path = pathPattern;
+
+	// A run of '#' characters in the path is replaced by the frame number,
+	// otherwise it's appended to the file name before the extension.
+	size_t placeholderStart = path.find('#');
+	size_t placeholderLength = 0;
+
+	if (placeholderStart != std::string::npos)
+	{
+		placeholderLength = path.find_first_not_of('#', placeholderStart);
+		placeholderLength = ((placeholderLength != std::string::npos) ? placeholderLength : path.size()) - placeholderStart;
+	}
+	else
+	{
+		const size_t nameStart = path.find_last_of("/\\");
+		const size_t extensionStart = path.find_last_of('.');
+
+		placeholderStart = ((extensionStart != std::string::npos) && (nameStart == std::string::npos || extensionStart > nameStart)) ? extensionStart : path.size();
+		path.insert(placeholderStart, "_");
+		placeholderStart++;
+	}
+
+	const size_t numDigits = std::max(placeholderLength ? placeholderLength : kMinFrameNumberDigits, std::to_string(numFrames - 1).size());
+
+	char frameNumber[32];
+	snprintf(frameNumber, sizeof(frameNumber), "%0*zu", static_cast<int>(numDigits), frame);
+
+	return path.replace(placeholderStart, placeholderLength, frameNumber);
+}
+
+std::string BatchRenderer::aovPath(const std::string& imagePath, Renderer::Aov aov) const
+{
+	// Each AOV is named after the image it accompanies, e.g. 'Frame_depth.pfm' for 'Frame.png'.
+	std::filesystem::path path(imagePath);
+	path.replace_filename(path.stem().string() + "_" + Renderer::AovName(aov) + ".pfm");
+
+	return path.string();
+}
+
+bool BatchRenderer::saveImage(const std::string& path)
+{
+	Image image;
+	image.width		= static_cast<uint32_t>(m_options.width);
+	image.height	= static_cast<uint32_t>(m_options.height);
+	image.pixels.assign(m_renderer.pixels(), m_renderer.pixels() + (m_options.width * m_options.height));
+
+	return image.save(path);
+}
+
+bool BatchRenderer::saveAov(const std::string& path, Renderer::Aov aov)
+{
+	const std::vector<Color> values = m_renderer.aov(aov);
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (! file)
+		return false;
+
+	// A little endian (as the negative scale says) color PFM, which stores its rows from the
+	// bottom of the image up.
+	file << "PF\n" << m_options.width << " " << m_options.height << "\n-1.0\n";
+
+	std::vector<float> line(m_options.width * 3);
+
+	for (size_t y = m_options.height; y-- > 0;)
+	{
+		for (size_t x = 0; x < m_options.width; x++)
+		{
+			const Color& value = values[(y * m_options.width) + x];
+
+			line[(x * 3) + 0] = static_cast<float>(value.red());
+			line[(x * 3) + 1] = static_cast<float>(value.green());
+			line[(x * 3) + 2] = static_cast<float>(value.blue());
+		}
+
+		file.write(reinterpret_cast<const char*>(line.data()), static_cast<std::streamsize>(line.size() * sizeof(float)));
+	}
+
+	return static_cast<bool>(file.flush());
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "Engine/Renderer.hpp"
+#include "Engine/ThreadPlacement.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+class BatchRenderer
+{
+public:
+	enum ExitCode
+	{
+		Success				= 0,
+		InvalidArguments	= 1,
+		SceneLoadFailed		= 2,
+		ImageSaveFailed		= 3,
+		NetworkFailed		= 4,
+		CheckpointInvalid	= 5,
+	};
+
+	struct Options
+	{
+		std::string									scenePath;
+		std::string									outputPath;
+
+		size_t										width = 1920;
+		size_t										height = 1080;
+
+		std::optional<uint32_t>						samplesPerPixel;
+		std::optional<std::chrono::milliseconds>	timeBudget;
+
+		size_t										numRenderThreads = 1;
+		ThreadAffinity								affinity = ThreadAffinity::None;
+
+		std::optional<std::string>					checkpointPath;
+		std::chrono::seconds						checkpointInterval = std::chrono::seconds(300);
+		bool										resume = false;
+
+		bool										denoise = false;
+
+		// Written next to each image, as floating point PFM files named after it.
+		std::vector<Renderer::Aov>					aovs;
+	};
+
+	explicit				BatchRenderer(const Options& options);
+
+	ExitCode				render();
+
+private:
+	ExitCode				renderFrame(const std::string& outputPath, const std::optional<std::string>& checkpointPath);
+	ExitCode				startOrResumeRender(const std::optional<std::string>& checkpointPath);
+	std::string				framePath(const std::string& pathPattern, size_t frame, size_t numFrames) const;
+	std::string				aovPath(const std::string& imagePath, Renderer::Aov aov) const;
+
+	bool					saveImage(const std::string& path);
+	bool					saveAov(const std::string& path, Renderer::Aov aov);
+
+private:
+	Options					m_options;
+	Renderer				m_renderer;
+	uint64_t				m_sceneHash = 0;
+};
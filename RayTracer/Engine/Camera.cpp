@@ -1,11 +1,28 @@
 #include "Engine/Camera.hpp"
 
 #include "Engine/MathUtil.hpp"
-#include "Engine/Ray.hpp"
-#include "Engine/Scene.hpp"
+#include "Engine/Random.hpp"
+#include "Engine/Sampling.hpp"
 
 #include <cassert>
 
+Camera Camera::Interpolate(const Camera& from, const Camera& to, double amount)
+{
+	const auto lerp = [amount](const auto& a, const auto& b) { return a + ((b - a) * amount); };
+
+	Transform transform;
+	transform.setPosition(lerp(from.transform().position(), to.transform().position()));
+	transform.setRotation(lerp(from.transform().rotation(), to.transform().rotation()));
+	transform.setScale(lerp(from.transform().scale(), to.transform().scale()));
+
+	return Camera(
+		transform,
+		lerp(from.aspectRatio(), to.aspectRatio()),
+		lerp(from.verticalFov(), to.verticalFov()),
+		lerp(from.focusDistance(), to.focusDistance()),
+		lerp(from.aperture(), to.aperture()));
+}
+
 Camera::Camera()
 	: Camera(Transform(), 16.0 / 9.0, MathUtil::DegreesToRadians(90), 1.0, 0.0)
 {
@@ -52,7 +69,7 @@ void Camera::setAperture(double aperture)
 	update();
 }
 
-Color Camera::trace(const Scene& scene, double u, double v) const
+Ray Camera::generateRay(double u, double v) const
 {
 	assert(u == std::clamp(u, 0.0, 1.0));
 	assert(v == std::clamp(v, 0.0, 1.0));
@@ -62,17 +79,16 @@ Color Camera::trace(const Scene& scene, double u, double v) const
 
 	if (m_defocusRadius)
 	{
-		const Vector defocusX	= StandardVectors::kUnitX * (Random::SignedNormal() * m_defocusRadius);
-		const Vector defocusY	= StandardVectors::kUnitY * (Random::SignedNormal() * m_defocusRadius);
-		const Vector defocusXY	= defocusX + defocusY;
+		// Pick a point on the (round) lens aperture.
+		const auto [lensU, lensV] = Random::Sample2D(Random::CameraDimension::Lens);
+
+		const Vector defocusXY = Sampling::ConcentricDisk(lensU, lensV) * m_defocusRadius;
 
 		rayOrigin		+= defocusXY;
 		rayDirection	-= defocusXY;
 	}
 
-	const Ray rayWorldSpace = Ray(m_transform.untransformPosition(rayOrigin), m_transform.untransformDirection(rayDirection).unit());
-
-	return rayWorldSpace.trace(scene, 0);
+	return Ray(m_transform.untransformPosition(rayOrigin), m_transform.untransformDirection(rayDirection).unit());
 }
 
 void Camera::update()
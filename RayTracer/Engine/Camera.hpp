@@ -1,14 +1,14 @@
 #pragma once
 
-#include "Engine/Color.hpp"
+#include "Engine/Ray.hpp"
 #include "Engine/Transform.hpp"
 #include "Engine/Vector.hpp"
 
-struct Scene;
-
 class Camera
 {
 public:
+	static Camera		Interpolate(const Camera& from, const Camera& to, double amount);
+
 						Camera();
 
 						Camera(const Transform& transform, double aspectRatio, double verticalFov, double focusDistance, double aperture);
@@ -25,7 +25,7 @@ public:
 	void				setFocusDistance(double focusDistance);
 	void				setAperture(double aperture);
 
-	Color				trace(const Scene& scene, double u, double v) const;
+	Ray					generateRay(double u, double v) const;
 
 private:
 	void				update();
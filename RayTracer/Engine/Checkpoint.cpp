@@ -0,0 +1,174 @@
+#include "Engine/Checkpoint.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+namespace
+{
+	constexpr char kMagic[4] = { 'R', 'T', 'C', 'P' };
+	constexpr uint32_t kVersion = 5;
+
+	template <typename T>
+	void Write(std::ofstream& file, const T& value)
+	{
+		file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+	}
+
+	template <typename T>
+	bool Read(std::ifstream& file, T& value)
+	{
+		return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(value)));
+	}
+}
+
+std::optional<Checkpoint> Checkpoint::Load(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (! file)
+		return std::nullopt;
+
+	char magic[sizeof(kMagic)] = {};
+	uint32_t version = 0;
+
+	if (! Read(file, magic) || ! std::equal(std::begin(magic), std::end(magic), std::begin(kMagic)) || ! Read(file, version) || version != kVersion)
+		return std::nullopt;
+
+	Checkpoint checkpoint;
+	uint64_t numGuideRecords = 0;
+	uint64_t numCacheRecords = 0;
+
+	const bool validHeader =
+		Read(file, checkpoint.sceneHash) &&
+		Read(file, checkpoint.seed) &&
+		Read(file, checkpoint.width) &&
+		Read(file, checkpoint.height) &&
+		Read(file, checkpoint.samplesPerPixel) &&
+		Read(file, checkpoint.samplesPerPass) &&
+		Read(file, checkpoint.completedPasses) &&
+		Read(file, numGuideRecords) &&
+		Read(file, numCacheRecords);
+
+	if (! validHeader)
+		return std::nullopt;
+
+	const size_t numPixels = static_cast<size_t>(checkpoint.width) * checkpoint.height;
+
+	// Check the file really holds a buffer of the size described, rather than
+	// trusting a possibly truncated header.
+	std::error_code error;
+	const auto fileSize = std::filesystem::file_size(path, error);
+	if (error || fileSize != static_cast<uintmax_t>(file.tellg()) + (numPixels * (sizeof(double) * 10 + sizeof(uint32_t) * 3)) + ((numGuideRecords + numCacheRecords) * sizeof(uint64_t)))
+		return std::nullopt;
+
+	checkpoint.accumulatedSamples.resize(numPixels);
+	checkpoint.sampleCounts.resize(numPixels);
+	checkpoint.accumulatedFeatures.resize(numPixels);
+	checkpoint.objectIds.resize(numPixels);
+	checkpoint.materialIds.resize(numPixels);
+	checkpoint.guideRecords.resize(numGuideRecords);
+	checkpoint.cacheRecords.resize(numCacheRecords);
+
+	for (auto& sample : checkpoint.accumulatedSamples)
+	{
+		double red = 0, green = 0, blue = 0;
+		Read(file, red);
+		Read(file, green);
+		Read(file, blue);
+
+		sample = Color(red, green, blue);
+	}
+
+	file.read(reinterpret_cast<char*>(checkpoint.sampleCounts.data()), static_cast<std::streamsize>(numPixels * sizeof(uint32_t)));
+
+	for (auto& features : checkpoint.accumulatedFeatures)
+	{
+		double red = 0, green = 0, blue = 0;
+		Read(file, red);
+		Read(file, green);
+		Read(file, blue);
+
+		double x = 0, y = 0, z = 0;
+		Read(file, x);
+		Read(file, y);
+		Read(file, z);
+
+		double depth = 0;
+		Read(file, depth);
+
+		features = Features{ .albedo = Color(red, green, blue), .normal = Vector(x, y, z), .depth = depth, .object = nullptr };
+	}
+
+	file.read(reinterpret_cast<char*>(checkpoint.objectIds.data()), static_cast<std::streamsize>(numPixels * sizeof(uint32_t)));
+	file.read(reinterpret_cast<char*>(checkpoint.materialIds.data()), static_cast<std::streamsize>(numPixels * sizeof(uint32_t)));
+	file.read(reinterpret_cast<char*>(checkpoint.guideRecords.data()), static_cast<std::streamsize>(numGuideRecords * sizeof(uint64_t)));
+	file.read(reinterpret_cast<char*>(checkpoint.cacheRecords.data()), static_cast<std::streamsize>(numCacheRecords * sizeof(uint64_t)));
+
+	if (! file)
+		return std::nullopt;
+
+	return checkpoint;
+}
+
+bool Checkpoint::save(const std::string& path) const
+{
+	// Write to a temporary file first and then move it into place, so that a render
+	// interrupted part way through saving still leaves the previous checkpoint intact.
+	const std::string temporaryPath = path + ".tmp";
+
+	{
+		std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+		if (! file)
+			return false;
+
+		Write(file, kMagic);
+		Write(file, kVersion);
+
+		Write(file, sceneHash);
+		Write(file, seed);
+		Write(file, width);
+		Write(file, height);
+		Write(file, samplesPerPixel);
+		Write(file, samplesPerPass);
+		Write(file, completedPasses);
+		Write(file, static_cast<uint64_t>(guideRecords.size()));
+		Write(file, static_cast<uint64_t>(cacheRecords.size()));
+
+		for (const auto& sample : accumulatedSamples)
+		{
+			Write(file, sample.red());
+			Write(file, sample.green());
+			Write(file, sample.blue());
+		}
+
+		file.write(reinterpret_cast<const char*>(sampleCounts.data()), static_cast<std::streamsize>(sampleCounts.size() * sizeof(uint32_t)));
+
+		for (const auto& features : accumulatedFeatures)
+		{
+			Write(file, features.albedo.red());
+			Write(file, features.albedo.green());
+			Write(file, features.albedo.blue());
+
+			Write(file, features.normal.x());
+			Write(file, features.normal.y());
+			Write(file, features.normal.z());
+
+			Write(file, features.depth);
+		}
+
+		file.write(reinterpret_cast<const char*>(objectIds.data()), static_cast<std::streamsize>(objectIds.size() * sizeof(uint32_t)));
+		file.write(reinterpret_cast<const char*>(materialIds.data()), static_cast<std::streamsize>(materialIds.size() * sizeof(uint32_t)));
+		file.write(reinterpret_cast<const char*>(guideRecords.data()), static_cast<std::streamsize>(guideRecords.size() * sizeof(uint64_t)));
+		file.write(reinterpret_cast<const char*>(cacheRecords.data()), static_cast<std::streamsize>(cacheRecords.size() * sizeof(uint64_t)));
+
+		if (! file.flush())
+			return false;
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temporaryPath, path, error);
+
+	return ! error;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Engine/Color.hpp"
+#include "Engine/Features.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Snapshot of a render taken between passes, from which Renderer can resume.
+struct Checkpoint
+{
+public:
+	static std::optional<Checkpoint>	Load(const std::string& path);
+
+	bool								save(const std::string& path) const;
+
+	uint64_t							sceneHash = 0;
+	uint64_t							seed = 0;
+
+	uint32_t							width = 0;
+	uint32_t							height = 0;
+
+	uint32_t							samplesPerPixel = 0;
+	uint32_t							samplesPerPass = 0;
+	uint32_t							completedPasses = 0;
+
+	std::vector<Color>					accumulatedSamples;
+	std::vector<uint32_t>				sampleCounts;
+	std::vector<Features>				accumulatedFeatures;
+	std::vector<uint32_t>				objectIds;
+	std::vector<uint32_t>				materialIds;
+
+	// What the path guide had learned, if the render was guided.
+	std::vector<uint64_t>				guideRecords;
+
+	// What the radiance cache had recorded, if it was enabled.
+	std::vector<uint64_t>				cacheRecords;
+};
@@ -146,6 +146,11 @@ public:
 		return (m_red + m_green + m_blue) / 3;
 	}
 
+	constexpr double		luminance() const
+	{
+		return (m_red * 0.2126) + (m_green * 0.7152) + (m_blue * 0.0722);
+	}
+
 	constexpr Color			clamped() const
 	{
 		return Color(
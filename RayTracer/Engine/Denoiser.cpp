@@ -0,0 +1,251 @@
+#include "Engine/Denoiser.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <utility>
+
+namespace
+{
+	constexpr int kNumPasses				= 5;
+	constexpr int kVarianceRadius			= 2;
+
+	// The weights of the B3 spline kernel each pass blurs with, by distance from its center tap.
+	constexpr double kKernelWeights[]		= { 3.0 / 8, 1.0 / 4, 1.0 / 16 };
+	constexpr double kVarianceBlurWeights[]	= { 1.0 / 2, 1.0 / 4 };
+
+	// How sharply each feature's edges stop the blur.
+	constexpr int kNormalSharpness			= 3;		// Normals' cosine raised to the power of 2^3
+	constexpr double kDepthSigma			= 2;
+	constexpr double kDepthTolerance		= 2e-2;		// Relative to the pixel's depth
+	constexpr double kMinDepthTolerance		= 1e-6;
+	constexpr double kLuminanceSigma		= 4;
+	constexpr double kMinLuminanceTolerance	= 1e-6;
+
+	// Keeps dividing out the albedo of very dark surfaces from amplifying their noise unboundedly.
+	constexpr double kMinAlbedo				= 1e-3;
+
+	Color DemodulationAlbedo(const Color& albedo)
+	{
+		return Color(std::max(albedo.red(), kMinAlbedo), std::max(albedo.green(), kMinAlbedo), std::max(albedo.blue(), kMinAlbedo));
+	}
+
+	// The smaller of the one-sided differences either side of a pixel, so that a depth gradient
+	// is never measured across a silhouette.
+	double DepthGradient(const double* before, double depth, const double* after)
+	{
+		if (! before || ! after)
+			return after ? *after - depth : (before ? depth - *before : 0);
+
+		return std::abs(*after - depth) < std::abs(depth - *before) ? *after - depth : depth - *before;
+	}
+}
+
+Denoiser::Denoiser(size_t width, size_t height, RunOnThreads runOnThreads)
+	: m_width(width)
+	, m_height(height)
+	, m_runOnThreads(std::move(runOnThreads))
+	, m_albedos(width * height)
+	, m_guides(width * height)
+	, m_illumination(width * height)
+	, m_filteredIllumination(width * height)
+{
+
+}
+
+std::vector<Color> Denoiser::denoise(std::span<const Color> colors, std::span<const Features> features)
+{
+	// Each stage reads the neighbors of its pixels as the previous stage left them, so
+	// the threads finish every line of a stage before any starts on the next.
+	forEachLine([&](size_t y) { prepareLine(y, colors, features); });
+	forEachLine([&](size_t y) { estimateVarianceLine(y); });
+
+	for (int pass = 0; pass < kNumPasses; pass++)
+	{
+		forEachLine([&](size_t y) { filterLine(y, 1 << pass); });
+
+		std::swap(m_illumination, m_filteredIllumination);
+	}
+
+	std::vector<Color> denoised(m_width * m_height);
+
+	for (size_t pixel = 0; pixel < denoised.size(); pixel++)
+		denoised[pixel] = (m_illumination[pixel].light * DemodulationAlbedo(m_albedos[pixel])).clamped();
+
+	return denoised;
+}
+
+template <typename Function>
+void Denoiser::forEachLine(const Function& function) const
+{
+	std::atomic<size_t> nextLine = 0;
+
+	m_runOnThreads(
+		[&]()
+		{
+			for (size_t y = nextLine++; y < m_height; y = nextLine++)
+				function(y);
+		});
+}
+
+void Denoiser::prepareLine(size_t y, std::span<const Color> colors, std::span<const Features> features)
+{
+	for (size_t x = 0; x < m_width; x++)
+	{
+		const size_t pixel = (y * m_width) + x;
+		const Features& pixelFeatures = features[pixel];
+
+		// Normals are averaged over the pixel's samples, so they're normalized again. Pixels
+		// that only saw the background have none.
+		const double normalLength = pixelFeatures.normal.length();
+
+		m_albedos[pixel] = pixelFeatures.albedo;
+
+		m_guides[pixel].normal	= normalLength > 0 ? pixelFeatures.normal / normalLength : Vector();
+		m_guides[pixel].depth	= pixelFeatures.depth;
+
+		m_illumination[pixel].light		= colors[pixel] / DemodulationAlbedo(pixelFeatures.albedo);
+		m_illumination[pixel].luminance	= m_illumination[pixel].light.luminance();
+	}
+}
+
+void Denoiser::estimateVarianceLine(size_t y)
+{
+	for (size_t x = 0; x < m_width; x++)
+	{
+		const size_t pixel = (y * m_width) + x;
+		Guide& guide = m_guides[pixel];
+
+		guide.depthGradientX = DepthGradient(x > 0 ? &m_guides[pixel - 1].depth : nullptr, guide.depth, x + 1 < m_width ? &m_guides[pixel + 1].depth : nullptr);
+		guide.depthGradientY = DepthGradient(y > 0 ? &m_guides[pixel - m_width].depth : nullptr, guide.depth, y + 1 < m_height ? &m_guides[pixel + m_width].depth : nullptr);
+	}
+
+	// Each pixel holds a single estimate of its light, so its noise is estimated from the
+	// spread of the light over the neighboring pixels on the same surface.
+	for (size_t x = 0; x < m_width; x++)
+	{
+		const size_t pixel = (y * m_width) + x;
+
+		double totalWeight = 0;
+		double mean = 0;
+		double meanSquare = 0;
+
+		for (int offsetY = -kVarianceRadius; offsetY <= kVarianceRadius; offsetY++)
+		{
+			const ptrdiff_t otherY = static_cast<ptrdiff_t>(y) + offsetY;
+			if (otherY < 0 || otherY >= static_cast<ptrdiff_t>(m_height))
+				continue;
+
+			for (int offsetX = -kVarianceRadius; offsetX <= kVarianceRadius; offsetX++)
+			{
+				const ptrdiff_t otherX = static_cast<ptrdiff_t>(x) + offsetX;
+				if (otherX < 0 || otherX >= static_cast<ptrdiff_t>(m_width))
+					continue;
+
+				const size_t other = (otherY * m_width) + otherX;
+
+				const double weight		= EdgeWeight(m_guides[pixel], m_guides[other], offsetX, offsetY, 0);
+				const double luminance	= m_illumination[other].luminance;
+
+				totalWeight	+= weight;
+				mean		+= weight * luminance;
+				meanSquare	+= weight * luminance * luminance;
+			}
+		}
+
+		mean /= totalWeight;
+		meanSquare /= totalWeight;
+
+		m_illumination[pixel].variance = std::max(meanSquare - (mean * mean), 0.0);
+	}
+}
+
+void Denoiser::filterLine(size_t y, int step)
+{
+	for (size_t x = 0; x < m_width; x++)
+	{
+		const size_t pixel = (y * m_width) + x;
+
+		const Guide& guide = m_guides[pixel];
+		const Illumination& illumination = m_illumination[pixel];
+
+		// The luminance edge stopping adapts to how noisy the pixel's surroundings still are,
+		// using the variance blurred slightly, to keep it from being fooled by the noise itself.
+		double variance = 0;
+		double varianceWeight = 0;
+
+		for (int offsetY = -1; offsetY <= 1; offsetY++)
+		{
+			const ptrdiff_t otherY = static_cast<ptrdiff_t>(y) + offsetY;
+			if (otherY < 0 || otherY >= static_cast<ptrdiff_t>(m_height))
+				continue;
+
+			for (int offsetX = -1; offsetX <= 1; offsetX++)
+			{
+				const ptrdiff_t otherX = static_cast<ptrdiff_t>(x) + offsetX;
+				if (otherX < 0 || otherX >= static_cast<ptrdiff_t>(m_width))
+					continue;
+
+				const double weight = kVarianceBlurWeights[std::abs(offsetX)] * kVarianceBlurWeights[std::abs(offsetY)];
+
+				variance		+= weight * m_illumination[(otherY * m_width) + otherX].variance;
+				varianceWeight	+= weight;
+			}
+		}
+
+		const double luminanceScale = 1 / ((kLuminanceSigma * std::sqrt(variance / varianceWeight)) + kMinLuminanceTolerance);
+
+		Illumination filtered;
+		double totalWeight = 0;
+
+		for (int tapY = -2; tapY <= 2; tapY++)
+		{
+			const ptrdiff_t otherY = static_cast<ptrdiff_t>(y) + (tapY * step);
+			if (otherY < 0 || otherY >= static_cast<ptrdiff_t>(m_height))
+				continue;
+
+			for (int tapX = -2; tapX <= 2; tapX++)
+			{
+				const ptrdiff_t otherX = static_cast<ptrdiff_t>(x) + (tapX * step);
+				if (otherX < 0 || otherX >= static_cast<ptrdiff_t>(m_width))
+					continue;
+
+				const size_t other = (otherY * m_width) + otherX;
+				const Illumination& otherIllumination = m_illumination[other];
+
+				const double luminanceDistance	= std::abs(illumination.luminance - otherIllumination.luminance) * luminanceScale;
+				const double weight				= kKernelWeights[std::abs(tapX)] * kKernelWeights[std::abs(tapY)] * EdgeWeight(guide, m_guides[other], tapX * step, tapY * step, luminanceDistance);
+
+				filtered.light		+= otherIllumination.light * weight;
+				filtered.variance	+= weight * weight * otherIllumination.variance;
+				totalWeight			+= weight;
+			}
+		}
+
+		filtered.light		/= totalWeight;
+		filtered.luminance	= filtered.light.luminance();
+		filtered.variance	/= totalWeight * totalWeight;
+
+		m_filteredIllumination[pixel] = filtered;
+	}
+}
+
+double Denoiser::EdgeWeight(const Guide& guide, const Guide& otherGuide, int offsetX, int offsetY, double luminanceDistance)
+{
+	// Pixels of the background only blend with each other.
+	double normalWeight = (guide.normal.lengthSquared() > 0 || otherGuide.normal.lengthSquared() > 0) ? std::max(guide.normal.dotProduct(otherGuide.normal), 0.0) : 1;
+	if (normalWeight <= 0)
+		return 0;
+
+	for (int i = 0; i < kNormalSharpness; i++)
+		normalWeight *= normalWeight;
+
+	// Depths are compared with what the pixel's depth gradient expects at the other pixel, so
+	// surfaces seen at a glancing angle aren't mistaken for edges.
+	const double expectedChange	= std::abs((guide.depthGradientX * offsetX) + (guide.depthGradientY * offsetY));
+	const double depthDistance	= std::abs(guide.depth - otherGuide.depth) / ((kDepthSigma * expectedChange) + (kDepthTolerance * guide.depth) + kMinDepthTolerance);
+
+	return normalWeight * std::exp(-(depthDistance + luminanceDistance));
+}
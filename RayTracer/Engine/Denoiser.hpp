@@ -0,0 +1,73 @@
+#pragma once
+
+#include "Engine/Color.hpp"
+#include "Engine/Features.hpp"
+#include "Engine/Vector.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <vector>
+
+// Removes most of the noise left in a render at low sample counts, guided by the features of
+// what each pixel's camera rays hit first. The render is filtered with an edge-avoiding a-trous
+// wavelet transform (Dammertz et al., "Edge-Avoiding A-Trous Wavelet Transform for Fast Global
+// Illumination Filtering"): a few passes of a small blur, each with its taps spread twice as far
+// apart as the last. Every tap is weighted down where it lies across an edge in the normals or
+// depths, or where its brightness differs by more than the noise around the pixel explains
+// (as in Schied et al., "Spatiotemporal Variance-Guided Filtering").
+//
+// It's the light arriving at each surface that's filtered, rather than its color: the albedo
+// is divided out beforehand and multiplied back in afterwards, so textures stay sharp.
+class Denoiser
+{
+public:
+	// Runs a function on a number of threads at once, returning once each call has finished.
+	// The calls share the work of each stage out between themselves.
+	using RunOnThreads = std::function<void(const std::function<void()>& function)>;
+
+								Denoiser(size_t width, size_t height, RunOnThreads runOnThreads);
+
+	std::vector<Color>			denoise(std::span<const Color> colors, std::span<const Features> features);
+
+private:
+	// The features of a pixel that edges are found in.
+	struct Guide
+	{
+		Vector					normal;
+		double					depth = 0;
+		double					depthGradientX = 0;
+		double					depthGradientY = 0;
+	};
+
+	// The light arriving at a pixel's surface, as it's filtered, with the luminance of the
+	// light and an estimate of the variance of its noise.
+	struct Illumination
+	{
+		Color					light;
+		double					luminance = 0;
+		double					variance = 0;
+	};
+
+	template <typename Function>
+	void						forEachLine(const Function& function) const;
+
+	void						prepareLine(size_t y, std::span<const Color> colors, std::span<const Features> features);
+	void						estimateVarianceLine(size_t y);
+	void						filterLine(size_t y, int step);
+
+	static double				EdgeWeight(const Guide& guide, const Guide& otherGuide, int offsetX, int offsetY, double luminanceDistance);
+
+private:
+	size_t						m_width;
+	size_t						m_height;
+	RunOnThreads				m_runOnThreads;
+
+	std::vector<Color>			m_albedos;
+	std::vector<Guide>			m_guides;
+
+	// Each pass reads the illumination left by the previous pass, and writes its own to the
+	// other buffer.
+	std::vector<Illumination>	m_illumination;
+	std::vector<Illumination>	m_filteredIllumination;
+};
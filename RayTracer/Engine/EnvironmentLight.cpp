@@ -0,0 +1,148 @@
+#include "Engine/EnvironmentLight.hpp"
+
+#include "Engine/MathUtil.hpp"
+#include "Engine/Random.hpp"
+#include "Engine/Scene.hpp"
+#include "Engine/Texture.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <span>
+
+namespace
+{
+	constexpr double kUniformTolerance = 1e-6;
+
+	// Picks an entry from a cumulative distribution (starting from zero), also giving how far
+	// through the entry's range the sample fell.
+	size_t SampleDistribution(std::span<const double> distribution, double sample, double& offset)
+	{
+		const auto	entry	= std::upper_bound(distribution.begin() + 1, distribution.end(), sample);
+		const size_t	index	= std::min<size_t>(entry - (distribution.begin() + 1), distribution.size() - 2);
+
+		const double range = distribution[index + 1] - distribution[index];
+		offset = range > 0 ? std::clamp((sample - distribution[index]) / range, 0.0, 1.0) : .5;
+
+		return index;
+	}
+
+	size_t TexelIndex(double coordinate, size_t size)
+	{
+		return std::min(static_cast<size_t>(std::max(coordinate, 0.0) * size), size - 1);
+	}
+}
+
+EnvironmentLight::EnvironmentLight(std::shared_ptr<const Texture> background)
+{
+	if (! background)
+		return;
+
+	const size_t width	= background->width();
+	const size_t height	= background->height();
+
+	// Weight each texel by its luminance, and by the solid angle it covers, which shrinks
+	// towards the poles.
+	std::vector<double> weights(width * height);
+
+	double minLuminance = std::numeric_limits<double>::max();
+	double maxLuminance = 0;
+
+	for (size_t y = 0; y < height; y++)
+	{
+		const double latitude = (((y + .5) / height) - .5) * std::numbers::pi;
+
+		for (size_t x = 0; x < width; x++)
+		{
+			const double luminance = std::max(background->sample((x + .5) / width, (y + .5) / height).luminance(), 0.0);
+
+			minLuminance = std::min(minLuminance, luminance);
+			maxLuminance = std::max(maxLuminance, luminance);
+
+			weights[(y * width) + x] = luminance * std::cos(latitude);
+		}
+	}
+
+	if (maxLuminance <= minLuminance * (1 + kUniformTolerance))
+		return;
+
+	m_width		= width;
+	m_height	= height;
+
+	m_rowDistribution.assign(height + 1, 0);
+	m_columnDistributions.assign(height * (width + 1), 0);
+
+	for (size_t y = 0; y < height; y++)
+	{
+		double* columns = &m_columnDistributions[y * (width + 1)];
+
+		for (size_t x = 0; x < width; x++)
+			columns[x + 1] = columns[x] + weights[(y * width) + x];
+
+		const double rowWeight = columns[width];
+
+		for (size_t x = 0; x < width; x++)
+			columns[x + 1] = rowWeight > 0 ? columns[x + 1] / rowWeight : (x + 1.0) / width;
+
+		m_rowDistribution[y + 1] = m_rowDistribution[y] + rowWeight;
+	}
+
+	const double totalWeight = m_rowDistribution[height];
+
+	for (auto& row : m_rowDistribution)
+		row /= totalWeight;
+
+	m_texelPdfs.resize(weights.size());
+	for (size_t i = 0; i < weights.size(); i++)
+		m_texelPdfs[i] = (weights[i] / totalWeight) * width * height;
+}
+
+Vector EnvironmentLight::sampleDirection(double& pdf) const
+{
+	const auto [rowSample, columnSample] = Random::Sample2D(Random::BounceDimension::Light);
+
+	double rowOffset;
+	const size_t y = SampleDistribution(m_rowDistribution, rowSample, rowOffset);
+
+	double columnOffset;
+	const size_t x = SampleDistribution(std::span(m_columnDistributions).subspan(y * (m_width + 1), m_width + 1), columnSample, columnOffset);
+
+	const double u = (x + columnOffset) / m_width;
+	const double v = (y + rowOffset) / m_height;
+
+	pdf = directionPdf(x, y, (v - .5) * std::numbers::pi);
+	return MathUtil::PolarToCartesian(Vector(u - .5, v - .5, 0));
+}
+
+double EnvironmentLight::pdf(const Vector& direction) const
+{
+	if (empty())
+		return 0;
+
+	// The inverse of the mapping from directions to the background texture, see Ray::background().
+	const Vector polarDirection = MathUtil::CartesianToPolar(direction);
+
+	const size_t x = TexelIndex(.5 + polarDirection.x(), m_width);
+	const size_t y = TexelIndex(.5 + polarDirection.y(), m_height);
+
+	return directionPdf(x, y, polarDirection.y() * std::numbers::pi);
+}
+
+double EnvironmentLight::directionPdf(size_t x, size_t y, double latitude) const
+{
+	// Convert the density over the texture into one over the directions it's mapped onto.
+	const double cosLatitude = std::cos(latitude);
+
+	return cosLatitude > 0 ? m_texelPdfs[(y * m_width) + x] / (2 * std::numbers::pi * std::numbers::pi * cosLatitude) : 0;
+}
+
+Color EnvironmentLight::traceEmission(const Scene& scene, const Ray& ray) const
+{
+	// Anything in the way casts a shadow.
+	double distance;
+	if (ray.closestIntersection(scene, distance))
+		return Palette::kBlack;
+
+	return ray.background(scene);
+}
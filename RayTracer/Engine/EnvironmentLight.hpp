@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Engine/Color.hpp"
+#include "Engine/Ray.hpp"
+#include "Engine/Vector.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+class Texture;
+
+struct Scene;
+
+// The scene's background, as a light that can be sampled directly. Directions are picked in
+// proportion to the background's luminance, from a distribution over its texture built when
+// the scene is loaded: first a row of texels, then a texel within that row.
+//
+// Uniform backgrounds are left empty; scattering already picks directions in proportion to
+// how much light they'd contribute from one of those.
+class EnvironmentLight
+{
+public:
+							EnvironmentLight() = default;
+	explicit				EnvironmentLight(std::shared_ptr<const Texture> background);
+
+	bool					empty() const { return m_texelPdfs.empty(); }
+
+	Vector					sampleDirection(double& pdf) const;
+	double					pdf(const Vector& direction) const;
+	Color					traceEmission(const Scene& scene, const Ray& ray) const;
+
+private:
+	double					directionPdf(size_t x, size_t y, double latitude) const;
+
+private:
+	size_t					m_width = 0;
+	size_t					m_height = 0;
+
+	// The density of picking each texel's area of the texture, and the cumulative
+	// distributions of picking each row, then each texel within a row.
+	std::vector<double>		m_texelPdfs;
+	std::vector<double>		m_rowDistribution;
+	std::vector<double>		m_columnDistributions;
+};
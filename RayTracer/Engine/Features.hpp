@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Engine/Color.hpp"
+#include "Engine/Vector.hpp"
+
+class Object;
+
+// What a camera ray hits first: the surface's albedo, its normal, and its distance along the
+// ray. These are recorded alongside the color of each sample, and averaged over a pixel's
+// samples in the same way, to guide the denoiser and fill the AOV buffers. A ray that hits
+// nothing records the background as its albedo, with no normal and no distance.
+//
+// The object hit can't be averaged, so it's left out of the sums; the ID buffers take it
+// from each pixel's first sample instead.
+struct Features
+{
+public:
+	constexpr Features&		operator+=(const Features& other)
+	{
+		albedo += other.albedo;
+		normal += other.normal;
+		depth += other.depth;
+
+		return *this;
+	}
+
+	constexpr Features		operator/(double factor) const
+	{
+		return Features{ .albedo = albedo / factor, .normal = normal / factor, .depth = depth / factor, .object = object };
+	}
+
+	Color					albedo;
+	Vector					normal;
+	double					depth = 0;
+	const Object*			object = nullptr;
+};
@@ -0,0 +1,224 @@
+#include "Engine/Image.hpp"
+
+#include <png.h>
+
+// jpeglib.h relies on FILE having been declared already.
+#include <cstdio>
+#include <jpeglib.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <csetjmp>
+#include <filesystem>
+
+namespace
+{
+	constexpr int kJpegQuality = 90;
+
+	constexpr std::array<uint8_t, 2> kJpegSignature = { 0xFF, 0xD8 };
+	constexpr size_t kPngSignatureSize = 8;
+
+	// libjpeg reports errors by calling error_exit, which mustn't return, so it jumps back out
+	// to where the file was opened. Everything that outlives the jump is created before it.
+	struct JpegErrorManager
+	{
+		jpeg_error_mgr		manager;
+		std::jmp_buf		jump;
+	};
+
+	[[noreturn]] void JpegErrorExit(j_common_ptr info)
+	{
+		(*info->err->output_message)(info);
+		std::longjmp(reinterpret_cast<JpegErrorManager*>(info->err)->jump, 1);
+	}
+
+	std::optional<Image> LoadPng(const std::string& path)
+	{
+		png_image png = {};
+		png.version = PNG_IMAGE_VERSION;
+
+		if (! png_image_begin_read_from_file(&png, path.c_str()))
+			return std::nullopt;
+
+		png.format = PNG_FORMAT_RGBA;
+
+		Image image;
+		image.width		= png.width;
+		image.height	= png.height;
+		image.pixels.resize(static_cast<size_t>(png.width) * png.height);
+
+		// libpng frees the image itself once it has been read, or if reading fails.
+		if (! png_image_finish_read(&png, nullptr, image.pixels.data(), 0, nullptr))
+			return std::nullopt;
+
+		return image;
+	}
+
+	bool SavePng(const std::string& path, const Image& image)
+	{
+		png_image png = {};
+		png.version	= PNG_IMAGE_VERSION;
+		png.width	= image.width;
+		png.height	= image.height;
+		png.format	= PNG_FORMAT_RGBA;
+
+		return png_image_write_to_file(&png, path.c_str(), 0, image.pixels.data(), 0, nullptr) != 0;
+	}
+
+	std::optional<Image> LoadJpeg(FILE* file)
+	{
+		jpeg_decompress_struct info = {};
+		JpegErrorManager error = {};
+
+		info.err = jpeg_std_error(&error.manager);
+		error.manager.error_exit = JpegErrorExit;
+
+		Image image;
+		std::vector<JSAMPLE> row;
+
+		if (setjmp(error.jump))
+		{
+			jpeg_destroy_decompress(&info);
+			return std::nullopt;
+		}
+
+		jpeg_create_decompress(&info);
+		jpeg_stdio_src(&info, file);
+		jpeg_read_header(&info, TRUE);
+
+		// Grayscale images are expanded here, as not every libjpeg can convert them to RGB.
+		info.out_color_space = (info.jpeg_color_space == JCS_GRAYSCALE) ? JCS_GRAYSCALE : JCS_RGB;
+		jpeg_start_decompress(&info);
+
+		const size_t components = static_cast<size_t>(info.output_components);
+
+		image.width		= info.output_width;
+		image.height	= info.output_height;
+		image.pixels.resize(static_cast<size_t>(image.width) * image.height);
+
+		row.resize(image.width * components);
+
+		while (info.output_scanline < info.output_height)
+		{
+			uint32_t* pixel = &image.pixels[static_cast<size_t>(info.output_scanline) * image.width];
+
+			JSAMPROW rowPointer = row.data();
+			jpeg_read_scanlines(&info, &rowPointer, 1);
+
+			for (size_t x = 0; x < image.width; x++)
+			{
+				const JSAMPLE* sample = &row[x * components];
+
+				const uint32_t red		= sample[0];
+				const uint32_t green	= sample[(components == 3) ? 1 : 0];
+				const uint32_t blue		= sample[(components == 3) ? 2 : 0];
+
+				pixel[x] = (255u << 24) | (blue << 16) | (green << 8) | red;
+			}
+		}
+
+		jpeg_finish_decompress(&info);
+		jpeg_destroy_decompress(&info);
+
+		return image;
+	}
+
+	bool SaveJpeg(FILE* file, const Image& image)
+	{
+		jpeg_compress_struct info = {};
+		JpegErrorManager error = {};
+
+		info.err = jpeg_std_error(&error.manager);
+		error.manager.error_exit = JpegErrorExit;
+
+		std::vector<JSAMPLE> row(static_cast<size_t>(image.width) * 3);
+
+		if (setjmp(error.jump))
+		{
+			jpeg_destroy_compress(&info);
+			return false;
+		}
+
+		jpeg_create_compress(&info);
+		jpeg_stdio_dest(&info, file);
+
+		info.image_width		= image.width;
+		info.image_height		= image.height;
+		info.input_components	= 3;
+		info.in_color_space		= JCS_RGB;
+
+		jpeg_set_defaults(&info);
+		jpeg_set_quality(&info, kJpegQuality, TRUE);
+		jpeg_start_compress(&info, TRUE);
+
+		// JPEG has no alpha channel, so it's dropped.
+		while (info.next_scanline < info.image_height)
+		{
+			const uint32_t* pixel = &image.pixels[static_cast<size_t>(info.next_scanline) * image.width];
+
+			for (size_t x = 0; x < image.width; x++)
+			{
+				row[(x * 3) + 0] = static_cast<JSAMPLE>(pixel[x] >> 0);
+				row[(x * 3) + 1] = static_cast<JSAMPLE>(pixel[x] >> 8);
+				row[(x * 3) + 2] = static_cast<JSAMPLE>(pixel[x] >> 16);
+			}
+
+			JSAMPROW rowPointer = row.data();
+			jpeg_write_scanlines(&info, &rowPointer, 1);
+		}
+
+		jpeg_finish_compress(&info);
+		jpeg_destroy_compress(&info);
+
+		return true;
+	}
+}
+
+std::optional<Image> Image::Load(const std::string& path)
+{
+	FILE* file = fopen(path.c_str(), "rb");
+	if (! file)
+		return std::nullopt;
+
+	// The format is recognized from the file's contents, whatever its extension.
+	std::array<uint8_t, kPngSignatureSize> signature = {};
+	const size_t signatureSize = fread(signature.data(), 1, signature.size(), file);
+
+	std::optional<Image> image;
+
+	if (signatureSize == signature.size() && png_sig_cmp(signature.data(), 0, signature.size()) == 0)
+	{
+		image = LoadPng(path);
+	}
+	else if (signatureSize >= kJpegSignature.size() && std::equal(kJpegSignature.begin(), kJpegSignature.end(), signature.begin()))
+	{
+		rewind(file);
+		image = LoadJpeg(file);
+	}
+
+	fclose(file);
+	return image;
+}
+
+bool Image::save(const std::string& path) const
+{
+	if (! width || ! height || pixels.size() != static_cast<size_t>(width) * height)
+		return false;
+
+	std::string extension = std::filesystem::path(path).extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+	if (extension == ".png")
+		return SavePng(path, *this);
+
+	if (extension != ".jpg" && extension != ".jpeg")
+		return false;
+
+	FILE* file = fopen(path.c_str(), "wb");
+	if (! file)
+		return false;
+
+	const bool saved = SaveJpeg(file, *this);
+	return (fclose(file) == 0) && saved;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// An 8 bit RGBA image, read from and written to PNG files with libpng and JPEG files with libjpeg.
+struct Image
+{
+public:
+	// Returns nothing if the file can't be read, or isn't a PNG or JPEG image.
+	static std::optional<Image>	Load(const std::string& path);
+
+	// The format is chosen by the path's extension: '.png', or '.jpg' or '.jpeg' for JPEG at a
+	// quality of 90. Returns false for any other extension, or if the file can't be written.
+	bool						save(const std::string& path) const;
+
+	uint32_t					width = 0;
+	uint32_t					height = 0;
+
+	// Row by row from the top left, in the same RGBA8888 layout as Color::toRGBA8888().
+	std::vector<uint32_t>		pixels;
+};
@@ -0,0 +1,178 @@
+#include "Engine/Light.hpp"
+
+#include "Engine/Material.hpp"
+#include "Engine/Object.hpp"
+#include "Engine/Random.hpp"
+#include "Engine/Sampling.hpp"
+#include "Engine/Scene.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+namespace
+{
+	constexpr size_t kPowerSamples			= 4;
+	constexpr double kPlaneDistanceTolerance	= 1e-6;
+}
+
+Light::Light(std::shared_ptr<const Object> object)
+	: m_object(std::move(object))
+	, m_boundingBox(m_object->boundingBox())
+	, m_center((m_boundingBox.lower() + m_boundingBox.upper()) / 2)
+	, m_radius(m_boundingBox.size().length() / 2)
+{
+	// Estimate the light's power from its average emission over its surface, and the surface
+	// area of its bounding sphere; only the relative power of lights matters.
+	Color emission;
+	for (size_t v = 0; v < kPowerSamples; v++)
+	{
+		for (size_t u = 0; u < kPowerSamples; u++)
+		{
+			const Vector uv = Vector(u + .5, v + .5, 0) / kPowerSamples;
+			emission += m_object->material().emit(StandardVectors::kZero, m_center, StandardVectors::kUnitY, uv);
+		}
+	}
+
+	m_power = (emission.average() / (kPowerSamples * kPowerSamples)) * (4 * std::numbers::pi * m_radius * m_radius);
+}
+
+Light::Light(std::shared_ptr<const Object> object, const SurfaceTriangle& triangle)
+	: m_object(std::move(object))
+	, m_triangle(triangle)
+{
+	const auto& [p0, p1, p2] = triangle.positions;
+
+	for (const auto& point : triangle.positions)
+		m_boundingBox.include(point);
+
+	m_center	= (m_boundingBox.lower() + m_boundingBox.upper()) / 2;
+	m_radius	= m_boundingBox.size().length() / 2;
+
+	const Vector normal = (p1 - p0).crossProduct(p2 - p0);
+
+	m_area		= normal.length() / 2;
+	m_normal	= m_area > 0 ? normal.unit() : StandardVectors::kUnitY;
+
+	// The triangle's power is its emission at its center, over its area.
+	const Vector center	= (p0 + p1 + p2) / 3;
+	const Vector uv		= (triangle.uvs[0] + triangle.uvs[1] + triangle.uvs[2]) / 3;
+
+	m_power = m_object->material().emit(StandardVectors::kZero, center, m_normal, uv).average() * m_area;
+}
+
+bool Light::canSample(const Vector& position) const
+{
+	if (m_triangle)
+		return m_area > 0 && std::abs(m_normal.dotProduct(position - m_triangle->positions[0])) > Object::kComparisonThreshold;
+
+	return (m_center - position).lengthSquared() > (m_radius * m_radius);
+}
+
+Vector Light::sampleDirection(const Vector& position, double& pdf) const
+{
+	assert(canSample(position));
+
+	if (m_triangle)
+	{
+		// Uniformly sample a point over the triangle's area.
+		const auto [u, v] = Random::Sample2D(Random::BounceDimension::Light);
+
+		const auto& [p0, p1, p2] = m_triangle->positions;
+		const Vector barycentric = Sampling::UniformTriangle(u, v);
+		const Vector point = (p0 * barycentric.x()) + (p1 * barycentric.y()) + (p2 * barycentric.z());
+
+		const Vector toPoint			= point - position;
+		const double distanceSquared	= toPoint.lengthSquared();
+		const Vector direction			= toPoint / std::sqrt(distanceSquared);
+
+		pdf = areaPdf(distanceSquared, direction);
+		return direction;
+	}
+
+	const Vector	toCenter		= m_center - position;
+	const double	distanceSquared	= toCenter.lengthSquared();
+	const double	coneSize		= this->coneSize(distanceSquared);
+
+	// Uniformly sample the cone around the direction to the sphere's center.
+	const auto [u, v] = Random::Sample2D(Random::BounceDimension::Light);
+
+	const Sampling::Frame frame(toCenter / std::sqrt(distanceSquared));
+
+	pdf = Sampling::UniformConePdf(coneSize);
+	return frame.toWorld(Sampling::UniformCone(u, v, coneSize)).unit();
+}
+
+double Light::pdf(const Vector& position, const Vector& direction) const
+{
+	if (! canSample(position))
+		return 0;
+
+	// For triangles, the direction is taken to be one that reaches the triangle.
+	if (m_triangle)
+	{
+		const double distance = planeDistance(Ray(position, direction));
+
+		return distance > 0 ? areaPdf(distance * distance, direction) : 0;
+	}
+
+	const Vector	toCenter		= m_center - position;
+	const double	distanceSquared	= toCenter.lengthSquared();
+	const double	coneSize		= this->coneSize(distanceSquared);
+
+	if (1 - (direction.dotProduct(toCenter) / std::sqrt(distanceSquared)) > coneSize)
+		return 0;
+
+	return Sampling::UniformConePdf(coneSize);
+}
+
+double Light::coneSize(double distanceSquared) const
+{
+	// The 1 - cos(angle) of the cone the bounding sphere subtends, rearranged to avoid
+	// cancellation for small or distant lights.
+	const double sinMaxAngleSquared = (m_radius * m_radius) / distanceSquared;
+
+	return sinMaxAngleSquared / (1 + std::sqrt(1 - sinMaxAngleSquared));
+}
+
+double Light::areaPdf(double distanceSquared, const Vector& direction) const
+{
+	// Convert the density over the triangle's area into one over the directions towards it.
+	// Light materials emit from both sides, so either side of the triangle can be sampled.
+	const double cosAngle = std::abs(m_normal.dotProduct(direction));
+
+	return cosAngle > 0 ? distanceSquared / (m_area * cosAngle) : 0;
+}
+
+double Light::planeDistance(const Ray& ray) const
+{
+	const double cosAngle = m_normal.dotProduct(ray.direction());
+	if (cosAngle == 0)
+		return Ray::kNoIntersection;
+
+	return m_normal.dotProduct(m_triangle->positions[0] - ray.position()) / cosAngle;
+}
+
+Color Light::traceEmission(const Scene& scene, const Ray& ray) const
+{
+	double distance;
+	const Object* closestObject = ray.closestIntersection(scene, distance);
+
+	// Anything else in the way casts a shadow; other lights included, as they're
+	// accounted for when they're sampled themselves.
+	if (closestObject != m_object.get())
+		return Palette::kBlack;
+
+	// Other triangles of the same mesh in front of this one shadow it too.
+	if (m_triangle && std::abs(distance - planeDistance(ray)) > kPlaneDistanceTolerance * distance)
+		return Palette::kBlack;
+
+	const Vector position = ray.at(distance);
+
+	Vector normal;
+	Vector uv;
+	Material& material = closestObject->getSurfaceProperties(ray, position, normal, uv);
+
+	return material.emit(ray.direction(), position, normal, uv);
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Engine/BoundingBox.hpp"
+#include "Engine/Color.hpp"
+#include "Engine/Object.hpp"
+#include "Engine/Ray.hpp"
+#include "Engine/Vector.hpp"
+
+#include <memory>
+#include <optional>
+
+struct Scene;
+
+// An emissive object, or one triangle of an emissive mesh, whose light can be sampled directly.
+//
+// Directions towards an object are picked from within the cone its bounding sphere subtends
+// from the point being lit, which works for any shape of object. Points within the bounding
+// sphere itself (such as those lit by a huge backdrop) would need the entire sphere of
+// directions sampled, so they're left to find the light by scattering instead.
+//
+// Triangles are sampled by picking a point uniformly over their area, so they can be sampled
+// from anywhere other than their own plane.
+class Light
+{
+public:
+	explicit						Light(std::shared_ptr<const Object> object);
+									Light(std::shared_ptr<const Object> object, const SurfaceTriangle& triangle);
+
+	const Object&					object() const		{ return *m_object; }
+	bool							isTriangle() const	{ return m_triangle.has_value(); }
+	const BoundingBox&				boundingBox() const	{ return m_boundingBox; }
+	const Vector&					center() const		{ return m_center; }
+	double							radius() const		{ return m_radius; }
+	double							power() const		{ return m_power; }
+
+	bool							canSample(const Vector& position) const;
+	Vector							sampleDirection(const Vector& position, double& pdf) const;
+	double							pdf(const Vector& position, const Vector& direction) const;
+	Color							traceEmission(const Scene& scene, const Ray& ray) const;
+
+private:
+	double							coneSize(double distanceSquared) const;
+	double							areaPdf(double distanceSquared, const Vector& direction) const;
+	double							planeDistance(const Ray& ray) const;
+
+private:
+	std::shared_ptr<const Object>	m_object;
+
+	BoundingBox						m_boundingBox;
+	Vector							m_center;
+	double							m_radius = 0;
+	double							m_power = 0;
+
+	std::optional<SurfaceTriangle>	m_triangle;
+	Vector							m_normal;
+	double							m_area = 0;
+};
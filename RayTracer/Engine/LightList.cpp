@@ -0,0 +1,140 @@
+#include "Engine/LightList.hpp"
+
+#include "Engine/Material.hpp"
+#include "Engine/MathUtil.hpp"
+#include "Engine/Object.hpp"
+#include "Engine/Random.hpp"
+
+#include <cmath>
+
+namespace
+{
+	constexpr double kEnvironmentProbability = .5;
+}
+
+LightList::LightList(const std::vector<std::shared_ptr<Object>>& objects, std::shared_ptr<const Texture> background)
+	: m_environment(std::move(background))
+{
+	for (const auto& object : objects)
+	{
+		if (! object->material().isLight() || ! std::isfinite(object->boundingBox().size().lengthSquared()))
+			continue;
+
+		m_lightIndices[object.get()] = m_lights.size();
+
+		// Objects made of triangles have each triangle sampled as a light of its own, in order,
+		// so a light can be told apart from the rest of its object by where it's hit.
+		const auto triangles = object->surfaceTriangles();
+
+		if (triangles.empty())
+			m_lights.emplace_back(object);
+
+		for (const auto& triangle : triangles)
+			m_lights.emplace_back(object, triangle);
+	}
+
+	m_tree = LightTree(m_lights);
+
+	// There's no common measure of how much light the background gives compared to objects,
+	// so a background worth sampling is sampled as often as all the objects together.
+	if (! m_environment.empty())
+		m_environmentProbability = m_lights.empty() ? 1 : kEnvironmentProbability;
+}
+
+const Light* LightList::find(const Object& object, const Vector& position) const
+{
+	const auto it = m_lightIndices.find(&object);
+	if (it == m_lightIndices.end())
+		return nullptr;
+
+	const Light& light = m_lights[it->second];
+	if (! light.isTriangle())
+		return &light;
+
+	const auto triangle = object.surfaceTriangleAt(position);
+
+	return triangle ? &m_lights[it->second + *triangle] : nullptr;
+}
+
+const Light* LightList::pick(const Vector& position, const Vector& normal, double& probability) const
+{
+	const auto index = m_tree.pick(position, normal, probability);
+
+	return index ? &m_lights[*index] : nullptr;
+}
+
+double LightList::pickProbability(const Light& light, const Vector& position, const Vector& normal) const
+{
+	return m_tree.probability(&light - m_lights.data(), position, normal);
+}
+
+std::optional<LightList::Sample> LightList::sample(const Vector& position, const Vector& normal) const
+{
+	Sample sample;
+
+	// Only spend a random number choosing between the background and objects when both can
+	// be sampled.
+	const bool sampleEnvironment = m_environmentProbability >= 1 || (m_environmentProbability > 0 && Random::Sample(Random::BounceDimension::LightSelection) < m_environmentProbability);
+
+	if (sampleEnvironment)
+	{
+		sample.direction	= m_environment.sampleDirection(sample.pdf);
+		sample.pdf			*= m_environmentProbability;
+	}
+	else
+	{
+		double pickProbability;
+		sample.light = pick(position, normal, pickProbability);
+
+		if (! sample.light || ! sample.light->canSample(position))
+			return std::nullopt;
+
+		sample.direction	= sample.light->sampleDirection(position, sample.pdf);
+		sample.pdf			*= pickProbability * (1 - m_environmentProbability);
+	}
+
+	if (sample.pdf <= 0)
+		return std::nullopt;
+
+	return sample;
+}
+
+double LightList::pdf(const Light* light, const Vector& position, const Vector& normal, const Vector& direction) const
+{
+	if (! light)
+		return m_environment.empty() ? 0 : m_environmentProbability * m_environment.pdf(direction);
+
+	return pickProbability(*light, position, normal) * (1 - m_environmentProbability) * light->pdf(position, direction);
+}
+
+Color LightList::traceEmission(const Scene& scene, const Light* light, const Ray& ray) const
+{
+	return light ? light->traceEmission(scene, ray) : m_environment.traceEmission(scene, ray);
+}
+
+double LightList::emissionWeight(const Object& object, const Vector& position, const Ray& ray, const Vector& normal, double scatterPdf) const
+{
+	// Weight the light reached by a scattered ray against the chance of it having been
+	// sampled directly from where the ray started, if lights were sampled there at all.
+	if (! scatterPdf)
+		return 1;
+
+	const Light* light = find(object, position);
+	if (! light)
+		return 1;
+
+	const double lightPdf = pdf(light, ray.position(), normal, ray.direction());
+
+	return MathUtil::PowerHeuristic(scatterPdf, lightPdf);
+}
+
+double LightList::backgroundWeight(const Ray& ray, double scatterPdf) const
+{
+	// As above, for a scattered ray that escapes the scene.
+	if (! scatterPdf || m_environment.empty())
+		return 1;
+
+	const double lightPdf = pdf(nullptr, ray.position(), Vector(), ray.direction());
+
+	return MathUtil::PowerHeuristic(scatterPdf, lightPdf);
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Engine/EnvironmentLight.hpp"
+#include "Engine/Light.hpp"
+#include "Engine/LightTree.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+class Object;
+class Texture;
+
+// The lights of a scene that can be sampled directly; every object with a light material,
+// other than those without bounds (such as planes), which can only be hit by chance. Meshes
+// contribute a light for each of their triangles. Lights are picked by importance, from a
+// tree over them (see LightTree), which accounts for each triangle's area.
+//
+// The background can be sampled as well, unless it's uniform (see EnvironmentLight).
+class LightList
+{
+public:
+	struct Sample
+	{
+		Vector							direction;
+		double							pdf = 0;			// Including the probability of the light being picked
+		const Light*					light = nullptr;	// Or none, for the background
+	};
+
+										LightList() = default;
+										LightList(const std::vector<std::shared_ptr<Object>>& objects, std::shared_ptr<const Texture> background);
+
+	bool								empty() const	{ return m_lights.empty() && m_environment.empty(); }
+	size_t								size() const	{ return m_lights.size(); }
+
+	const Light*						find(const Object& object, const Vector& position) const;
+
+	std::optional<Sample>				sample(const Vector& position, const Vector& normal) const;
+
+	// The density of sample() choosing a direction from a position, for a direction that
+	// reaches the given light (or the background, for none).
+	double								pdf(const Light* light, const Vector& position, const Vector& normal, const Vector& direction) const;
+	Color								traceEmission(const Scene& scene, const Light* light, const Ray& ray) const;
+
+	double								emissionWeight(const Object& object, const Vector& position, const Ray& ray, const Vector& normal, double scatterPdf) const;
+	double								backgroundWeight(const Ray& ray, double scatterPdf) const;
+
+private:
+	const Light*						pick(const Vector& position, const Vector& normal, double& probability) const;
+	double								pickProbability(const Light& light, const Vector& position, const Vector& normal) const;
+
+private:
+	std::vector<Light>					m_lights;
+	std::unordered_map<const Object*, size_t>	m_lightIndices;
+	LightTree							m_tree;
+
+	EnvironmentLight					m_environment;
+	double								m_environmentProbability = 0;
+};
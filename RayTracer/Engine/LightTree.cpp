@@ -0,0 +1,187 @@
+#include "Engine/LightTree.hpp"
+
+#include "Engine/Light.hpp"
+#include "Engine/Object.hpp"
+#include "Engine/Random.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+LightTree::LightTree(const std::vector<Light>& lights)
+{
+	if (lights.empty())
+		return;
+
+	std::vector<size_t> lightIndices(lights.size());
+	std::iota(lightIndices.begin(), lightIndices.end(), 0);
+
+	m_nodes.reserve((lights.size() * 2) - 1);
+	m_leaves.resize(lights.size());
+
+	build(lights, lightIndices, 0, lights.size(), kNoNode);
+}
+
+size_t LightTree::build(const std::vector<Light>& lights, std::vector<size_t>& lightIndices, size_t first, size_t last, size_t parent)
+{
+	const size_t nodeIndex = m_nodes.size();
+	m_nodes.emplace_back();
+
+	Node node;
+	node.parent = parent;
+
+	for (size_t i = first; i < last; i++)
+	{
+		const Light& light = lights[lightIndices[i]];
+
+		node.boundingBox.include(light.boundingBox().lower());
+		node.boundingBox.include(light.boundingBox().upper());
+		node.power += light.power();
+	}
+
+	if (last - first == 1)
+	{
+		const Light& light = lights[lightIndices[first]];
+
+		node.center			= light.center();
+		node.radius			= light.radius();
+		node.light			= lightIndices[first];
+		node.sampledWithin	= light.isTriangle();
+
+		m_leaves[node.light] = nodeIndex;
+	}
+	else
+	{
+		node.center	= (node.boundingBox.lower() + node.boundingBox.upper()) / 2;
+		node.radius	= node.boundingBox.size().length() / 2;
+
+		// Split the lights in half along the axis their centers are most spread out on, which
+		// keeps the tree balanced however the lights are laid out.
+		BoundingBox centers;
+		for (size_t i = first; i < last; i++)
+			centers.include(lights[lightIndices[i]].center());
+
+		const Vector	spread	= centers.size();
+		const int		axis	= (spread.x() >= spread.y() && spread.x() >= spread.z()) ? 0 : (spread.y() >= spread.z() ? 1 : 2);
+
+		const auto component = [axis](const Vector& vector) { return axis == 0 ? vector.x() : (axis == 1 ? vector.y() : vector.z()); };
+
+		const size_t middle = first + ((last - first) / 2);
+		std::nth_element(lightIndices.begin() + first, lightIndices.begin() + middle, lightIndices.begin() + last,
+			[&](size_t a, size_t b)
+			{
+				return component(lights[a].center()) < component(lights[b].center());
+			});
+
+		node.children[0] = build(lights, lightIndices, first, middle, nodeIndex);
+		node.children[1] = build(lights, lightIndices, middle, last, nodeIndex);
+	}
+
+	m_nodes[nodeIndex] = node;
+	return nodeIndex;
+}
+
+std::optional<size_t> LightTree::pick(const Vector& position, const Vector& normal, double& probability) const
+{
+	if (m_nodes.empty())
+		return std::nullopt;
+
+	// A single random number picks the path down the tree, rescaled at each node to the range
+	// of the child it chose.
+	double sample = Random::Sample(Random::BounceDimension::LightPick);
+
+	size_t nodeIndex = 0;
+	probability = 1;
+
+	while (m_nodes[nodeIndex].children[0] != kNoNode)
+	{
+		const Node& node = m_nodes[nodeIndex];
+
+		const double leftImportance		= importance(m_nodes[node.children[0]], position, normal);
+		const double rightImportance	= importance(m_nodes[node.children[1]], position, normal);
+		const double totalImportance	= leftImportance + rightImportance;
+
+		if (totalImportance <= 0)
+			return std::nullopt;
+
+		const double leftProbability = leftImportance / totalImportance;
+
+		if (sample < leftProbability)
+		{
+			sample		/= leftProbability;
+			probability	*= leftProbability;
+			nodeIndex	= node.children[0];
+		}
+		else
+		{
+			sample		= (sample - leftProbability) / (1 - leftProbability);
+			probability	*= rightImportance / totalImportance;
+			nodeIndex	= node.children[1];
+		}
+
+		sample = std::min(sample, std::nextafter(1.0, 0.0));
+	}
+
+	if (importance(m_nodes[nodeIndex], position, normal) <= 0)
+		return std::nullopt;
+
+	return m_nodes[nodeIndex].light;
+}
+
+double LightTree::probability(size_t light, const Vector& position, const Vector& normal) const
+{
+	size_t nodeIndex = m_leaves[light];
+
+	if (importance(m_nodes[nodeIndex], position, normal) <= 0)
+		return 0;
+
+	// Walk back up the tree, gathering the probability of each choice made on the way down.
+	double probability = 1;
+
+	for (size_t parentIndex = m_nodes[nodeIndex].parent; parentIndex != kNoNode; nodeIndex = parentIndex, parentIndex = m_nodes[nodeIndex].parent)
+	{
+		const Node& parent = m_nodes[parentIndex];
+
+		const double leftImportance		= importance(m_nodes[parent.children[0]], position, normal);
+		const double rightImportance	= importance(m_nodes[parent.children[1]], position, normal);
+		const double totalImportance	= leftImportance + rightImportance;
+
+		if (totalImportance <= 0)
+			return 0;
+
+		probability *= (nodeIndex == parent.children[0] ? leftImportance : rightImportance) / totalImportance;
+	}
+
+	return probability;
+}
+
+double LightTree::importance(const Node& node, const Vector& position, const Vector& normal) const
+{
+	const Vector	toCenter		= node.center - position;
+	const double	distanceSquared	= toCenter.lengthSquared();
+	const double	radiusSquared	= node.radius * node.radius;
+
+	// Within a node's bounds its lights could be in any direction, at any distance. Most single
+	// lights can't be sampled from within their own bounds at all.
+	if (distanceSquared <= radiusSquared)
+		return (node.children[0] == kNoNode && ! node.sampledWithin) ? 0 : node.power / std::max(radiusSquared, Object::kComparisonThreshold);
+
+	// Bound the cosine with the normal by the smallest angle between it and any direction
+	// within the cone the node's bounding sphere subtends.
+	const double distance		= std::sqrt(distanceSquared);
+	const double cosAngle		= std::clamp(normal.dotProduct(toCenter) / distance, -1.0, 1.0);
+	const double sinMaxAngle	= node.radius / distance;
+	const double cosMaxAngle	= std::sqrt(1 - (sinMaxAngle * sinMaxAngle));
+
+	double cosBound = 1;
+	if (cosAngle < cosMaxAngle)
+	{
+		const double sinAngle = std::sqrt(1 - (cosAngle * cosAngle));
+		cosBound = (cosAngle * cosMaxAngle) + (sinAngle * sinMaxAngle);
+	}
+
+	if (cosBound <= 0)
+		return 0;
+
+	return node.power * cosBound / distanceSquared;
+}
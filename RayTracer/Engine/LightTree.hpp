@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Engine/BoundingBox.hpp"
+#include "Engine/Vector.hpp"
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+class Light;
+
+// A bounding volume hierarchy over a scene's lights, for picking a light to sample in
+// proportion to how much it's likely to contribute to a point, in logarithmic time.
+//
+// Each node's importance is its lights' combined power, over the squared distance to its
+// bounds, times the most that the cosine with the surface normal could be for any direction
+// towards them; so lights that are far away, dim, or entirely below the surface's horizon
+// are rarely, if ever, picked. Lights emit in every direction, so only the orientation of
+// the surface being lit needs bounding.
+class LightTree
+{
+public:
+								LightTree() = default;
+	explicit					LightTree(const std::vector<Light>& lights);
+
+	std::optional<size_t>		pick(const Vector& position, const Vector& normal, double& probability) const;
+	double						probability(size_t light, const Vector& position, const Vector& normal) const;
+
+private:
+	static inline constexpr size_t kNoNode = static_cast<size_t>(-1);
+
+	struct Node
+	{
+		BoundingBox				boundingBox;
+		Vector					center;
+		double					radius = 0;
+		double					power = 0;
+
+		size_t					parent = kNoNode;
+		std::array<size_t, 2>	children = { kNoNode, kNoNode };
+
+		// The index of the light, for leaf nodes (which have no children), and whether it can
+		// be sampled from within its own bounds.
+		size_t					light = 0;
+		bool					sampledWithin = false;
+	};
+
+	size_t						build(const std::vector<Light>& lights, std::vector<size_t>& lightIndices, size_t first, size_t last, size_t parent);
+	double						importance(const Node& node, const Vector& position, const Vector& normal) const;
+
+private:
+	std::vector<Node>			m_nodes;
+	std::vector<size_t>			m_leaves;
+};
@@ -50,38 +50,14 @@ Vector Material::mapNormal(const Vector& normal, const Vector& tangent, const Ve
 	return Vector(output(0, 0), output(0, 1), output(0, 2)).unit();
 }
 
-Color Material::illuminate(const Scene& scene, const Ray& sourceRay, const Vector& position, const Vector& normal, const Vector& uv, uint32_t rayDepth)
+Color Material::albedo(const Vector& uv) const
 {
-	Color finalColor = emit(sourceRay.direction(), position, normal, uv);
-
-	Color attenuation;
-	double pdf;
-	if (auto scatterRay = scatter(sourceRay.direction(), position, normal, uv, attenuation, pdf))
-	{
-		// Russian roulette termination; once we've reached at least three
-		// bounces, start pruning rays based on the survival probability.
-		if (rayDepth > 3)
-		{
-			// Never allow a survival probability of 1.0, or we could potentially
-			// never terminate.
-			const double survivalProbability = std::min(attenuation.average(), 0.90);
-
-			// Check if we need to terminate this ray, or boost it based on the
-			// survival probability.
-			if (Random::UnsignedNormal() > survivalProbability)
-				attenuation = Color();
-			else
-				attenuation /= survivalProbability;
-		}
-
-		if (attenuation != Color())
-		{
-			double scatteringPdf = scatterPdf(sourceRay.direction(), position, normal, scatterRay->direction());
-			finalColor += attenuation * scatteringPdf * scatterRay->trace(scene, rayDepth) / pdf;
-		}
-	}
-
-	return finalColor;
+	return m_texture->sample(uv.x(), uv.y());
+}
+
+void Material::bounce(const LightList& lights, Bounce& bounce)
+{
+	BounceWith(*this, lights, bounce);
 }
 
 Vector Material::reflect(const Vector& incident, const Vector& normal) const
@@ -93,7 +69,9 @@ std::optional<Vector> Material::refract(const Vector& incident, const Vector& no
 {
 	// https://graphics.stanford.edu/courses/cs148-10-summer/docs/2006--degreve--reflection_refraction.pdf
 
-	double cosI		= incident.dotProduct(normal);
+	// The normal faces against the incident direction, so the cosine of the angle between them
+	// is that of the incident direction reversed.
+	double cosI		= -incident.dotProduct(normal);
 	double sinT2	= (refractiveIndexRatio * refractiveIndexRatio) * (1.0 - (cosI * cosI));
 
 	if (sinT2 > 1.0)
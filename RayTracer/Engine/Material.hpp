@@ -1,11 +1,22 @@
 #pragma once
 
 #include "Engine/Color.hpp"
+#include "Engine/Light.hpp"
+#include "Engine/LightList.hpp"
+#include "Engine/MathUtil.hpp"
+#include "Engine/PathGuide.hpp"
+#include "Engine/PhotonMap.hpp"
+#include "Engine/Random.hpp"
 #include "Engine/Ray.hpp"
 #include "Engine/Vector.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
+#include <numbers>
 #include <optional>
+#include <span>
+#include <utility>
 
 class Texture;
 
@@ -14,19 +25,93 @@ struct Scene;
 class Material
 {
 public:
+	// A single bounce of a path off a hit on the material.
+	struct Bounce
+	{
+		Vector								incident;
+		Vector								position;
+		Vector								normal;
+		Vector								uv;
+		uint32_t							rayDepth = 0;
+		double								emissionWeight = 1;
+		Random::Sequence					sequence;
+
+		// The light emitted back along the incident ray, along with any caustics gathered from
+		// the photon map that are reflected along it.
+		Color								emitted;
+
+		// The ray the path continues along, unless it's absorbed, and the weight of its light.
+		std::optional<Ray>					scatterRay;
+		Color								weight;
+
+		// A shadow ray towards a directly sampled light (or the background, if there's no light),
+		// and the weight of the light's emission if the ray reaches it unobstructed.
+		std::optional<Ray>					lightRay;
+		const Light*						light = nullptr;
+		Color								lightWeight;
+
+		// Where lights were sampled directly, the pdf the scatter ray was chosen with, so that
+		// the emission of any light it reaches can be weighted against that light's sampling
+		// (see LightList::emissionWeight); zero otherwise.
+		double								scatterPdf = 0;
+
+		// The path guide to steer the scattered ray with, if any. Where the guide applies to
+		// the material, the pdf the ray was chosen with, so that the light it brings back can
+		// be recorded to train the guide; zero otherwise.
+		PathGuide*							guide = nullptr;
+		double								recordPdf = 0;
+
+		// The photon map to gather caustics from, if any, and how the incident and scattered
+		// rays relate to the caustics it gathers.
+		const PhotonMap*					photons = nullptr;
+		PhotonMap::CausticPath				causticPath = PhotonMap::CausticPath::None;
+		PhotonMap::CausticPath				scatterCausticPath = PhotonMap::CausticPath::None;
+	};
+
 									Material(std::shared_ptr<Texture> texture, std::shared_ptr<Texture> normals);
 	virtual							~Material() = default;
 
 	Vector							mapNormal(const Vector& normal, const Vector& tangent, const Vector& bitangent, const Vector& uv) const;
-	Color							illuminate(const Scene& scene, const Ray& sourceRay, const Vector& position, const Vector& normal, const Vector& uv, uint32_t rayDepth);
+
+	// The color of the material's surface, recorded as a feature of the first hit of each path.
+	Color							albedo(const Vector& uv) const;
+
+	// Bounces a path off a hit on the material, using the calling thread's random sequence.
+	void							bounce(const LightList& lights, Bounce& bounce);
+
+	// Bounces a batch of hits on this material, each using the random sequence of its own path.
+	// Materials override this to shade the batch in a single loop over their concrete type,
+	// rather than with virtual calls for every hit.
+	virtual void					bounceAll(const LightList& lights, std::span<Bounce> bounces)													{ BounceAllWith(*this, lights, bounces); }
 
 public:
+	virtual bool					isLight() const																										{ return false; }
+
 	virtual Color					emit(const Vector& incident, const Vector& position, const Vector& normal, const Vector& uv)										{ return Palette::kBlack; }
 
 	virtual std::optional<Ray>		scatter(const Vector& incident, const Vector& position, const Vector& normal, const Vector& uv, Color& attenuation, double& pdf)	{ return std::nullopt; }
 	virtual	double					scatterPdf(const Vector& incident, const Vector& position, const Vector& normal, const Vector& scatteredDirection)					{ return 0; }
 
+	// Materials that scatter light over a range of directions can have lights sampled directly,
+	// with evaluate() giving the proportion of the light arriving from a direction that's
+	// scattered back along the incident ray, and the pdf of scatter() choosing that direction.
+	virtual bool					canSampleLights() const																										{ return false; }
+	virtual Color					evaluate(const Vector& incident, const Vector& position, const Vector& normal, const Vector& uv, const Vector& direction, double& pdf)	{ pdf = 0; return Palette::kBlack; }
+
+	// Materials that reflect light equally in every direction, so the light leaving them
+	// doesn't depend on the direction they're seen from.
+	virtual bool					isDiffuse() const																									{ return false; }
+
 protected:
+	template <typename MaterialType>
+	static void						BounceWith(MaterialType& material, const LightList& lights, Bounce& bounce);
+
+	template <typename MaterialType>
+	static std::optional<Ray>		GuidedScatter(MaterialType& material, const PathGuide::Distribution& distribution, const Bounce& bounce, Color& attenuation, double& pdf);
+
+	template <typename MaterialType>
+	static void						BounceAllWith(MaterialType& material, const LightList& lights, std::span<Bounce> bounces);
+
 	Vector							reflect(const Vector& incident, const Vector& normal) const;
 	std::optional<Vector>			refract(const Vector& incident, const Vector& normal, double refractiveIndexRatio) const;
 
@@ -34,3 +119,158 @@ protected:
 	const std::shared_ptr<Texture>	m_texture;
 	const std::shared_ptr<Texture>	m_normals;
 };
+
+// Called with the concrete material type where it's known, so that (with the material
+// classes all being final) the calls below are resolved at compile time.
+template <typename MaterialType>
+void Material::BounceWith(MaterialType& material, const LightList& lights, Bounce& bounce)
+{
+	const Vector& incident	= bounce.incident;
+	const Vector& position	= bounce.position;
+	const Vector& normal	= bounce.normal;
+	const Vector& uv		= bounce.uv;
+
+	Random::SetBounce(bounce.rayDepth);
+
+	bounce.emitted = material.emit(incident, position, normal, uv) * bounce.emissionWeight;
+
+	bounce.scatterRay.reset();
+	bounce.lightRay.reset();
+	bounce.light = nullptr;
+	bounce.scatterPdf = 0;
+	bounce.recordPdf = 0;
+	bounce.scatterCausticPath = PhotonMap::CausticPath::None;
+
+	// Surfaces that lights can be sampled from gather their caustics from the photons that
+	// landed around the hit, each reflected as the material would reflect light arriving from
+	// the photon's direction. Specular surfaces only pass on whether the path gathered them.
+	if (bounce.photons && material.canSampleLights())
+	{
+		Color caustics;
+
+		bounce.photons->gather(position,
+			[&](const Vector& direction, const Color& flux)
+			{
+				// The response includes the cosine of the angle the light arrives at, which
+				// the photon's flux already accounts for.
+				const double cosAngle = std::abs(normal.dotProduct(direction));
+
+				double photonPdf;
+				if (cosAngle > 0)
+					caustics += material.evaluate(incident, position, normal, uv, direction.inverted(), photonPdf) * flux / cosAngle;
+			});
+
+		const double radius = bounce.photons->radius();
+
+		bounce.emitted += caustics / (std::numbers::pi * radius * radius);
+		bounce.scatterCausticPath = PhotonMap::CausticPath::Leaving;
+	}
+	else if (bounce.causticPath != PhotonMap::CausticPath::None)
+	{
+		bounce.scatterCausticPath = PhotonMap::CausticPath::Specular;
+	}
+
+	const bool sampleLights = material.canSampleLights() && ! lights.empty();
+
+	// Only materials that can be evaluated for any direction can be guided, as guided rays
+	// are weighted by the pdfs of both ways of choosing them.
+	const bool guided = bounce.guide && material.canSampleLights();
+	const PathGuide::Distribution* distribution = guided ? bounce.guide->distribution(position) : nullptr;
+
+	// Sample one of the lights directly, rather than relying on the scattered ray to find them.
+	// Both ways of reaching a light are combined using multiple importance sampling, so each
+	// is weighted towards whichever is better at finding that particular light.
+	if (sampleLights)
+	{
+		if (const auto sample = lights.sample(position, normal))
+		{
+			double scatterPdf;
+			const Color response = material.evaluate(incident, position, normal, uv, sample->direction, scatterPdf);
+
+			if (distribution)
+				scatterPdf = PathGuide::CombinedPdf(*distribution, sample->direction, scatterPdf);
+
+			if (response != Color())
+			{
+				bounce.lightRay		= Ray(position, sample->direction);
+				bounce.light		= sample->light;
+				bounce.lightWeight	= response * (MathUtil::PowerHeuristic(sample->pdf, scatterPdf) / sample->pdf);
+			}
+		}
+	}
+
+	Color attenuation;
+	double pdf;
+	if (auto scattered = distribution ? GuidedScatter(material, *distribution, bounce, attenuation, pdf) : material.scatter(incident, position, normal, uv, attenuation, pdf))
+	{
+		// Russian roulette termination; once we've reached at least three
+		// bounces, start pruning rays based on the survival probability.
+		if (bounce.rayDepth > 3)
+		{
+			// Never allow a survival probability of 1.0, or we could potentially
+			// never terminate.
+			const double survivalProbability = std::min(attenuation.average(), 0.90);
+
+			// Check if we need to terminate this ray, or boost it based on the
+			// survival probability.
+			if (Random::Sample(Random::BounceDimension::Roulette) > survivalProbability)
+				attenuation = Color();
+			else
+				attenuation /= survivalProbability;
+		}
+
+		if (attenuation != Color())
+		{
+			// Guided rays' attenuation is already divided by the pdf they were chosen with.
+			bounce.weight		= distribution ? attenuation : attenuation * material.scatterPdf(incident, position, normal, scattered->direction()) / pdf;
+			bounce.scatterRay	= scattered;
+			bounce.scatterPdf	= sampleLights ? pdf : 0;
+			bounce.recordPdf	= guided ? pdf : 0;
+		}
+	}
+}
+
+template <typename MaterialType>
+std::optional<Ray> Material::GuidedScatter(MaterialType& material, const PathGuide::Distribution& distribution, const Bounce& bounce, Color& attenuation, double& pdf)
+{
+	// Scatter either towards where the guide has learned that light arrives from, or as the
+	// material would, and weight the ray by the pdf of the two choices combined.
+	std::optional<Ray> scattered;
+
+	if (Random::Sample(Random::BounceDimension::GuideSelection) < PathGuide::kGuidedFraction)
+	{
+		const auto [u, v] = Random::Sample2D(Random::BounceDimension::Scatter);
+
+		scattered = Ray(bounce.position, PathGuide::Sample(distribution, u, v));
+	}
+	else
+	{
+		scattered = material.scatter(bounce.incident, bounce.position, bounce.normal, bounce.uv, attenuation, pdf);
+	}
+
+	if (! scattered)
+		return std::nullopt;
+
+	double materialPdf;
+	const Color response = material.evaluate(bounce.incident, bounce.position, bounce.normal, bounce.uv, scattered->direction(), materialPdf);
+
+	pdf = PathGuide::CombinedPdf(distribution, scattered->direction(), materialPdf);
+
+	// Directions the material doesn't scatter towards are absorbed.
+	if (response == Color() || pdf <= 0)
+		return std::nullopt;
+
+	attenuation = response / pdf;
+	return scattered;
+}
+
+template <typename MaterialType>
+void Material::BounceAllWith(MaterialType& material, const LightList& lights, std::span<Bounce> bounces)
+{
+	for (auto& bounce : bounces)
+	{
+		std::swap(Random::CurrentSequence(), bounce.sequence);
+		BounceWith(material, lights, bounce);
+		std::swap(Random::CurrentSequence(), bounce.sequence);
+	}
+}
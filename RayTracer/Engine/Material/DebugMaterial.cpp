@@ -24,3 +24,8 @@ Color DebugMaterial::emit(const Vector& incident, const Vector& position, const
 
 	return Palette::kMagenta;
 }
+
+void DebugMaterial::bounceAll(const LightList& lights, std::span<Bounce> bounces)
+{
+	BounceAllWith(*this, lights, bounces);
+}
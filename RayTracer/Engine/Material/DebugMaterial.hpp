@@ -4,6 +4,7 @@
 #include "Engine/Ray.hpp"
 
 #include <memory>
+#include <span>
 
 class Texture;
 
@@ -22,6 +23,7 @@ public:
 
 // Material i/f:
 public:
+	void					bounceAll(const LightList& lights, std::span<Bounce> bounces) override;
 	Color					emit(const Vector& incident, const Vector& position, const Vector& normal, const Vector& uv) override;
 
 private:
@@ -1,5 +1,6 @@
 #include "DielectricMaterial.hpp"
 
+#include "Engine/Random.hpp"
 #include "Engine/Ray.hpp"
 #include "Engine/Texture.hpp"
 #include "Engine/Vector.hpp"
@@ -47,7 +48,7 @@ std::optional<Ray> DielectricMaterial::scatter(const Vector& incident, const Vec
 	std::optional<Vector> refractionDirection;
 
 	double cosAngle = std::min(incident.inverted().dotProduct(refractionNormal), 1.0);
-	if (Reflectance(cosAngle, refractionIndex) <= Random::UnsignedNormal())
+	if (Reflectance(cosAngle, refractionIndex) <= Random::Sample(Random::BounceDimension::Scatter))
 		refractionDirection = refract(incident, refractionNormal, refractionIndex);
 
 	// Refract if possible, otherwise reflect.
@@ -62,3 +63,8 @@ double DielectricMaterial::scatterPdf(const Vector& incident, const Vector& posi
 {
 	 return 1;
 }
+
+void DielectricMaterial::bounceAll(const LightList& lights, std::span<Bounce> bounces)
+{
+	BounceAllWith(*this, lights, bounces);
+}
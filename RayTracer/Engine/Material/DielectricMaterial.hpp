@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <optional>
+#include <span>
 
 class Texture;
 
@@ -17,6 +18,7 @@ public:
 
 // Material i/f:
 public:
+	void					bounceAll(const LightList& lights, std::span<Bounce> bounces) override;
 	std::optional<Ray>		scatter(const Vector& incident, const Vector& position, const Vector& normal, const Vector& uv, Color& albedo, double& pdf) override;
 	double					scatterPdf(const Vector& incident, const Vector& position, const Vector& normal, const Vector& scatteredDirection) override;
 
@@ -1,11 +1,11 @@
 #include "DiffuseMaterial.hpp"
 
+#include "Engine/Random.hpp"
 #include "Engine/Ray.hpp"
+#include "Engine/Sampling.hpp"
 #include "Engine/Texture.hpp"
 #include "Engine/Vector.hpp"
 
-#include <numbers>
-
 DiffuseMaterial::DiffuseMaterial(std::shared_ptr<Texture> texture, std::shared_ptr<Texture> normals)
 	: Material(std::move(texture), std::move(normals))
 {
@@ -14,18 +14,30 @@ DiffuseMaterial::DiffuseMaterial(std::shared_ptr<Texture> texture, std::shared_p
 
 std::optional<Ray> DiffuseMaterial::scatter(const Vector& incident, const Vector& position, const Vector& normal, const Vector& uv, Color& attenuation, double& pdf)
 {
-	// Scatter across the unit hemisphere around the surface normal.
-	auto scatterDirection = normal + VectorUtils::RandomUnitVector();
-	if (scatterDirection.lengthSquared() < 1e-10)
-		scatterDirection = normal;
+	// Scatter across the hemisphere around the surface normal, in proportion to the cosine of
+	// the angle with it, which is how a diffuse surface reflects light.
+	const auto [u, v] = Random::Sample2D(Random::BounceDimension::Scatter);
+
+	const Vector scatterDirection = Sampling::Frame(normal).toWorld(Sampling::CosineHemisphere(u, v));
 
 	attenuation = m_texture->sample(uv.x(), uv.y());
-	pdf = 1 / (2 * std::numbers::pi);
-	return Ray(position, scatterDirection.unit());
+	pdf = scatterPdf(incident, position, normal, scatterDirection);
+	return Ray(position, scatterDirection);
 }
 
 double DiffuseMaterial::scatterPdf(const Vector& incident, const Vector& position, const Vector& normal, const Vector& scatteredDirection)
 {
-	 auto cosTheta = normal.dotProduct(scatteredDirection);
-	 return cosTheta < 0 ? 0 : cosTheta / std::numbers::pi;
+	 return Sampling::CosineHemispherePdf(normal.dotProduct(scatteredDirection));
+}
+
+Color DiffuseMaterial::evaluate(const Vector& incident, const Vector& position, const Vector& normal, const Vector& uv, const Vector& direction, double& pdf)
+{
+	pdf = scatterPdf(incident, position, normal, direction);
+
+	return m_texture->sample(uv.x(), uv.y()) * pdf;
+}
+
+void DiffuseMaterial::bounceAll(const LightList& lights, std::span<Bounce> bounces)
+{
+	BounceAllWith(*this, lights, bounces);
 }
@@ -14,3 +14,8 @@ Color LightMaterial::emit(const Vector& incident, const Vector& position, const
 {
 	return m_texture->sample(uv.x(), uv.y());
 }
+
+void LightMaterial::bounceAll(const LightList& lights, std::span<Bounce> bounces)
+{
+	BounceAllWith(*this, lights, bounces);
+}
@@ -1,37 +1,102 @@
 #include "ReflectiveMaterial.hpp"
 
+#include "Engine/Random.hpp"
 #include "Engine/Ray.hpp"
+#include "Engine/Sampling.hpp"
 #include "Engine/Texture.hpp"
 #include "Engine/Vector.hpp"
 
 #include <algorithm>
 
+namespace
+{
+	// Before it was a microfacet material, an unpolished material scattered its reflections by
+	// adding a random unit vector scaled by 1 - polish. This scales 1 - polish into the GGX alpha
+	// whose reflections stray from the mirror direction by the same median angle, so that
+	// materials keep looking as blurry as they did.
+	constexpr double kRoughnessPerScuff = 0.43;
+}
+
 ReflectiveMaterial::ReflectiveMaterial(std::shared_ptr<Texture> texture, std::shared_ptr<Texture> normals, double polish)
 	: Material(std::move(texture), std::move(normals))
-	, m_scuff(std::clamp(1 - polish, 0.0, 1.0))
+	, m_roughness(std::clamp(1 - polish, 0.0, 1.0) * kRoughnessPerScuff)
 {
 
 }
 
 std::optional<Ray> ReflectiveMaterial::scatter(const Vector& incident, const Vector& position, const Vector& normal, const Vector& uv, Color& attenuation, double& pdf)
 {
-	// Reflect the incidence ray along the surface normal.
-	auto scatterDirection = reflect(incident, normal);
+	// A perfectly polished material reflects the incidence ray along the surface normal.
+	if (! m_roughness)
+	{
+		const auto scatterDirection = reflect(incident, normal);
+		if (scatterDirection.dotProduct(normal) < 0)
+			return std::nullopt;
 
-	// Perturb the reflected ray randomly, based on how (un-)polished this material is.
-	if (m_scuff)
-		scatterDirection = (scatterDirection + (VectorUtils::RandomUnitVector() * m_scuff)).unit();
+		attenuation = m_texture->sample(uv.x(), uv.y());
+		pdf = 1;
+		return Ray(position, scatterDirection);
+	}
 
-	// If the perturbed ray is now pointing into the surface, absorb it.
-	if (scatterDirection.dotProduct(normal) < 0)
+	// Otherwise reflect it off a microfacet normal, picked from those the incidence ray can see.
+	const Sampling::Frame	frame(normal);
+	const Vector			outgoing = frame.toLocal(incident.inverted());
+
+	if (outgoing.z() <= 0)
 		return std::nullopt;
 
-	attenuation = m_texture->sample(uv.x(), uv.y());
-	pdf = 1;
-	return Ray(position, scatterDirection);
+	const auto [u, v] = Random::Sample2D(Random::BounceDimension::Scatter);
+
+	const Vector halfway	= Sampling::GgxVisibleNormal(outgoing, m_roughness, u, v);
+	const Vector scattered	= (halfway * (2 * outgoing.dotProduct(halfway))) - outgoing;
+
+	// If the reflected ray is pointing into the surface, absorb it.
+	if (scattered.z() <= 0)
+		return std::nullopt;
+
+	// Dividing the reflectance by the pdf leaves only the shadowing the visible normals
+	// didn't already account for.
+	attenuation = m_texture->sample(uv.x(), uv.y()) * (Sampling::GgxShadowingMasking(outgoing, scattered, m_roughness) / Sampling::GgxMasking(outgoing, m_roughness));
+	pdf = Sampling::GgxReflectionPdf(outgoing, halfway, m_roughness);
+	return Ray(position, frame.toWorld(scattered));
 }
 
 double ReflectiveMaterial::scatterPdf(const Vector& incident, const Vector& position, const Vector& normal, const Vector& scatteredDirection)
 {
-	 return 1;
+	if (! m_roughness)
+		return 1;
+
+	const Sampling::Frame	frame(normal);
+	const Vector			outgoing	= frame.toLocal(incident.inverted());
+	const Vector			scattered	= frame.toLocal(scatteredDirection);
+
+	if (scattered.z() <= 0)
+		return 0;
+
+	return Sampling::GgxReflectionPdf(outgoing, (outgoing + scattered).unit(), m_roughness);
+}
+
+Color ReflectiveMaterial::evaluate(const Vector& incident, const Vector& position, const Vector& normal, const Vector& uv, const Vector& direction, double& pdf)
+{
+	const Sampling::Frame	frame(normal);
+	const Vector			outgoing	= frame.toLocal(incident.inverted());
+	const Vector			scattered	= frame.toLocal(direction);
+
+	pdf = 0;
+	if (outgoing.z() <= 0 || scattered.z() <= 0)
+		return Palette::kBlack;
+
+	const Vector halfway = (outgoing + scattered).unit();
+	pdf = Sampling::GgxReflectionPdf(outgoing, halfway, m_roughness);
+
+	// The microfacet reflectance, times the cosine of the angle the light arrives at.
+	const double distribution		= Sampling::GgxDistribution(halfway, m_roughness);
+	const double shadowingMasking	= Sampling::GgxShadowingMasking(outgoing, scattered, m_roughness);
+
+	return m_texture->sample(uv.x(), uv.y()) * (distribution * shadowingMasking / (4 * outgoing.z()));
+}
+
+void ReflectiveMaterial::bounceAll(const LightList& lights, std::span<Bounce> bounces)
+{
+	BounceAllWith(*this, lights, bounces);
 }
@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <optional>
+#include <span>
 
 class Texture;
 
@@ -17,9 +18,13 @@ public:
 
 // Material i/f:
 public:
+	void					bounceAll(const LightList& lights, std::span<Bounce> bounces) override;
 	std::optional<Ray>		scatter(const Vector& incident, const Vector& position, const Vector& normal, const Vector& uv, Color& attenuation, double& pdf) override;
 	double					scatterPdf(const Vector& incident, const Vector& position, const Vector& normal, const Vector& scatteredDirection) override;
+	bool					canSampleLights() const override { return m_roughness > 0; }
+	Color					evaluate(const Vector& incident, const Vector& position, const Vector& normal, const Vector& uv, const Vector& direction, double& pdf) override;
 
 private:
-	double					m_scuff;
+	// The GGX alpha of the material's microfacets; zero for a perfect mirror.
+	double					m_roughness;
 };
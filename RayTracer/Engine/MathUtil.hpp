@@ -17,6 +17,13 @@ namespace MathUtil
 		return radians * (180 / std::numbers::pi);
 	}
 
+	// Multiple importance sampling weight for a sample taken with one strategy, which another
+	// strategy could also have produced.
+	constexpr double PowerHeuristic(double pdf, double otherPdf)
+	{
+		return (pdf * pdf) / ((pdf * pdf) + (otherPdf * otherPdf));
+	}
+
 	constexpr Vector CartesianToPolar(const Vector& vector)
 	{
 		return Vector(
@@ -24,4 +31,15 @@ namespace MathUtil
 			std::asin(vector.y()) / std::numbers::pi,
 			0);
 	}
+
+	inline Vector PolarToCartesian(const Vector& polar)
+	{
+		const double longitude	= polar.x() * (2 * std::numbers::pi);
+		const double latitude	= polar.y() * std::numbers::pi;
+
+		return Vector(
+			std::cos(latitude) * std::cos(longitude),
+			std::sin(latitude),
+			std::cos(latitude) * std::sin(longitude));
+	}
 }
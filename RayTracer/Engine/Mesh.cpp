@@ -1,5 +1,7 @@
 #include "Engine/Mesh.hpp"
 
+#include <numeric>
+
 namespace
 {
 	constexpr auto kMaxOctreePartitionDepth		= 8;
@@ -8,20 +10,26 @@ namespace
 
 Mesh::Mesh(std::vector<Vertex> vertices, std::vector<Triangle> triangles)
 	: m_vertices(std::move(vertices))
+	, m_triangles(std::move(triangles))
 {
-	if (triangles.empty())
+	if (m_triangles.empty())
 		return;
 
 	m_vertices.shrink_to_fit();
+	m_triangles.shrink_to_fit();
+
+	// The tree refers to triangles by their index, so each can be identified wherever it's found.
+	TriangleList allTriangles(m_triangles.size());
+	std::iota(allTriangles.begin(), allTriangles.end(), 0);
 
 	// First find the bounding box for all triangles in the mesh.
-	BoundingBox meshBoundingBox = boundingBoxForTriangles(triangles);
-	printf("Partitioning mesh %s size %s - %zu triangles\n", meshBoundingBox.lower().string().c_str(), meshBoundingBox.size().string().c_str(), triangles.size());
+	BoundingBox meshBoundingBox = boundingBoxForTriangles(allTriangles);
+	printf("Partitioning mesh %s size %s - %zu triangles\n", meshBoundingBox.lower().string().c_str(), meshBoundingBox.size().string().c_str(), allTriangles.size());
 
 	// Now build a tree of all the triangles, storing a bounding box for each node,
 	// along with either a list of triangles that intersect that bounding box, or
 	// an array of children nodes to search.
-	auto newRoot = partition(std::move(triangles), 0);
+	auto newRoot = partition(std::move(allTriangles), 0);
 	m_root = newRoot ? std::move(*newRoot.release()) : Node{};
 
 	size_t nodeCount = 0;
@@ -31,14 +39,14 @@ Mesh::Mesh(std::vector<Vertex> vertices, std::vector<Triangle> triangles)
 			nodeCount++;
 			return true;
 		},
-		[](const std::vector<Vertex>&, const std::vector<Triangle>&)
+		[](const std::vector<Vertex>&, const std::vector<Triangle>&, const TriangleList&)
 		{
 			// NOP
 		});
 	printf("Partitioning complete, %zu nodes.\n", nodeCount);
 }
 
-std::unique_ptr<Mesh::Node> Mesh::partition(std::vector<Triangle> triangles, uint32_t depth)
+std::unique_ptr<Mesh::Node> Mesh::partition(TriangleList triangles, uint32_t depth)
 {
 	if (triangles.empty())
 		return nullptr;
@@ -81,7 +89,7 @@ std::unique_ptr<Mesh::Node> Mesh::partition(std::vector<Triangle> triangles, uin
 			Vector(oX, oY, oZ)
 		};
 
-	std::array<std::vector<Triangle>, kOffsets.size()> childrenTriangles;
+	std::array<TriangleList, kOffsets.size()> childrenTriangles;
 
 	// Determine which of our triangles intersect each child's bounding box.
 	for (size_t i = 0; i < kOffsets.size(); i++)
@@ -96,27 +104,27 @@ std::unique_ptr<Mesh::Node> Mesh::partition(std::vector<Triangle> triangles, uin
 	return node;
 }
 
-BoundingBox Mesh::boundingBoxForTriangles(const std::vector<Triangle>& triangles) const
+BoundingBox Mesh::boundingBoxForTriangles(const TriangleList& triangles) const
 {
 	BoundingBox trianglesBoundingBox;
 
-	for (const auto& triangle : triangles)
+	for (const size_t triangle : triangles)
 	{
-		for (const auto& point : triangle)
+		for (const auto& point : m_triangles[triangle])
 			trianglesBoundingBox.include(m_vertices[point].position);
 	}
 
 	return trianglesBoundingBox;
 }
 
-std::vector<Triangle> Mesh::trianglesInBox(const BoundingBox& boundingBox, const std::vector<Triangle>& triangles) const
+Mesh::TriangleList Mesh::trianglesInBox(const BoundingBox& boundingBox, const TriangleList& triangles) const
 {
-	std::vector<Triangle> matchedTriangles;
+	TriangleList matchedTriangles;
 
 	matchedTriangles.reserve(triangles.size());
-	for (const auto& triangle : triangles)
+	for (const size_t triangle : triangles)
 	{
-		if (boxContainsTriangle(boundingBox, triangle))
+		if (boxContainsTriangle(boundingBox, m_triangles[triangle]))
 		    matchedTriangles.push_back(triangle);
 	}
 	matchedTriangles.shrink_to_fit();
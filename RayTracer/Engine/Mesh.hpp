@@ -31,6 +31,9 @@ public:
 		return m_root.boundingBox;
 	}
 
+	const std::vector<Vertex>&		vertices() const	{ return m_vertices; }
+	const std::vector<Triangle>&	triangles() const	{ return m_triangles; }
+
 	template <typename BBTestCallable, typename TriangleCallable>
 	void					walk(BBTestCallable&& boundingBoxTest, TriangleCallable&& triangleTest) const
 	{
@@ -40,7 +43,7 @@ public:
 private:
 	struct Node;
 
-	using TriangleList	= std::vector<Triangle>;
+	using TriangleList	= std::vector<size_t>;
 	using ChildNodes	= std::array<std::unique_ptr<Node>, 8>;
 
 	struct Node
@@ -66,7 +69,7 @@ private:
 			{
 				[&](const TriangleList& triangles)
 				{
-					triangleTest(std::as_const(m_vertices), triangles);
+					triangleTest(std::as_const(m_vertices), std::as_const(m_triangles), triangles);
 				},
 				[&](const ChildNodes& children)
 				{
@@ -80,14 +83,15 @@ private:
 			node.contents);
 	}
 
-	std::unique_ptr<Node>	partition(std::vector<Triangle> triangles, uint32_t depth);
+	std::unique_ptr<Node>	partition(TriangleList triangles, uint32_t depth);
 
-	BoundingBox				boundingBoxForTriangles(const std::vector<Triangle>& triangles) const;
+	BoundingBox				boundingBoxForTriangles(const TriangleList& triangles) const;
 
-	std::vector<Triangle>	trianglesInBox(const BoundingBox& boundingBox, const std::vector<Triangle>& triangles) const;
+	TriangleList			trianglesInBox(const BoundingBox& boundingBox, const TriangleList& triangles) const;
 	bool					boxContainsTriangle(const BoundingBox& boundingBox, const Triangle& triangle) const;
 
 private:
 	std::vector<Vertex> 	m_vertices;
+	std::vector<Triangle>	m_triangles;
 	Node					m_root = {};
 };
@@ -34,7 +34,7 @@ double Object::intersect(const Ray& ray) const
 	return distance;
 }
 
-Color Object::illuminate(const Scene& scene, const Ray& ray, const Vector& position, uint32_t rayDepth) const
+Material& Object::getSurfaceProperties(const Ray& ray, const Vector& position, Vector& normal, Vector& uv) const
 {
 	const Vector	directionObjectSpace		= m_transform.transformDirection(ray.direction()).unit();
 	const Vector	positionObjectSpace 		= m_transform.transformPosition(position);
@@ -42,7 +42,6 @@ Color Object::illuminate(const Scene& scene, const Ray& ray, const Vector& posit
 	Vector normalObjectSpace;
 	Vector tangent;
 	Vector bitangent;
-	Vector uv;
 	getIntersectionProperties(directionObjectSpace, positionObjectSpace, normalObjectSpace, tangent, bitangent, uv);
 
 	assert(normalObjectSpace.isUnit());
@@ -54,9 +53,9 @@ Color Object::illuminate(const Scene& scene, const Ray& ray, const Vector& posit
 
 	assert(normalObjectSpace.isUnit());
 
-	const Vector 	normalWorldSpace			= m_transform.untransformDirection(normalObjectSpace).unit();
+	normal = m_transform.untransformDirection(normalObjectSpace).unit();
 
-	assert(normalWorldSpace.isUnit());
+	assert(normal.isUnit());
 
-	return m_material->illuminate(scene, ray, position, normalWorldSpace, uv, rayDepth);
+	return *m_material;
 }
@@ -5,15 +5,25 @@
 #include "Engine/Transform.hpp"
 #include "Engine/Vector.hpp"
 
+#include <array>
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <optional>
+#include <vector>
 
 class Material;
 class Ray;
 
 struct Scene;
 
+// A triangle of an object's surface, in world space.
+struct SurfaceTriangle
+{
+	std::array<Vector, 3>			positions;
+	std::array<Vector, 3>			uvs;
+};
+
 class Object
 {
 public:
@@ -23,8 +33,15 @@ public:
 	virtual							~Object() = default;
 
 	const BoundingBox&				boundingBox() const { return m_boundingBox; }
+	const Transform&				transform() const { return m_transform; }
+	Material&						material() const { return *m_material; }
 	double							intersect(const Ray& ray) const;
-	Color							illuminate(const Scene& scene, const Ray& ray, const Vector& position, uint32_t rayDepth) const;
+	Material&						getSurfaceProperties(const Ray& ray, const Vector& position, Vector& normal, Vector& uv) const;
+
+	// Objects made up of triangles list them, so that each can be sampled as a light of its own,
+	// and can tell which of them a point on their surface lies on.
+	virtual std::vector<SurfaceTriangle>	surfaceTriangles() const							{ return {}; }
+	virtual std::optional<size_t>			surfaceTriangleAt(const Vector& position) const	{ return std::nullopt; }
 
 protected:
 	virtual double					intersectWith(const Ray& ray) const = 0;
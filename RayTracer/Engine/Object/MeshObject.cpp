@@ -24,13 +24,13 @@ double MeshObject::intersectWith(const Ray& ray) const
 		{
 			return boundingBox.intersect(ray) < distance;
 		},
-		[&](const std::vector<Vertex>& vertices, const std::vector<Triangle>& triangles)
+		[&](const std::vector<Vertex>& vertices, const std::vector<Triangle>& triangles, const std::vector<size_t>& nodeTriangles)
 		{
 			// If we intersect, find the distance to the closest triangle in this node (if any).
 
-			for (const auto& triangle : triangles)
+			for (const size_t triangle : nodeTriangles)
 			{
-				const auto& [p0, p1, p2] = triangle;
+				const auto& [p0, p1, p2] = triangles[triangle];
 
 				const Vertex& v0 = vertices[p0];
 				const Vertex& v1 = vertices[p1];
@@ -45,7 +45,62 @@ double MeshObject::intersectWith(const Ray& ray) const
 
 void MeshObject::getIntersectionProperties(const Vector& direction, const Vector& position, Vector& normal, Vector& tangent, Vector& bitangent, Vector& uv) const
 {
-	bool found = false;
+	const auto triangle = triangleAt(position);
+
+	if (! triangle)
+	{
+		assert(false);
+
+		normal		= StandardVectors::kUnitZ;
+		tangent		= StandardVectors::kUnitY;
+		bitangent	= StandardVectors::kUnitX;
+		uv			= StandardVectors::kZero;
+		return;
+	}
+
+	const auto& [p0, p1, p2] = m_mesh->triangles()[*triangle];
+
+	const Vertex& v0 = m_mesh->vertices()[p0];
+	const Vertex& v1 = m_mesh->vertices()[p1];
+	const Vertex& v2 = m_mesh->vertices()[p2];
+
+	const Vector mix = interpolate(position, v0, v1, v2);
+
+	normal		= normalAt(v0, v1, v2, mix);
+	tangent		= (v1.position - v0.position).unit();
+	bitangent	= (v2.position - v1.position).unit();
+	uv			= uvAt(v0, v1, v2, mix);
+}
+
+std::vector<SurfaceTriangle> MeshObject::surfaceTriangles() const
+{
+	std::vector<SurfaceTriangle> surfaceTriangles;
+	surfaceTriangles.reserve(m_mesh->triangles().size());
+
+	for (const auto& triangle : m_mesh->triangles())
+	{
+		SurfaceTriangle& surfaceTriangle = surfaceTriangles.emplace_back();
+
+		for (size_t i = 0; i < triangle.size(); i++)
+		{
+			const Vertex& vertex = m_mesh->vertices()[triangle[i]];
+
+			surfaceTriangle.positions[i]	= transform().untransformPosition(vertex.position);
+			surfaceTriangle.uvs[i]			= vertex.texture;
+		}
+	}
+
+	return surfaceTriangles;
+}
+
+std::optional<size_t> MeshObject::surfaceTriangleAt(const Vector& position) const
+{
+	return triangleAt(transform().transformPosition(position));
+}
+
+std::optional<size_t> MeshObject::triangleAt(const Vector& position) const
+{
+	std::optional<size_t> found;
 
 	m_mesh->walk(
 		[&](const BoundingBox& boundingBox) -> bool
@@ -57,42 +112,23 @@ void MeshObject::getIntersectionProperties(const Vector& direction, const Vector
 			// If our search point is contained in the bounding box, search this node.
 			return boundingBox.contains(position);
 		},
-		[&](const std::vector<Vertex>& vertices, const std::vector<Triangle>& triangles)
+		[&](const std::vector<Vertex>& vertices, const std::vector<Triangle>& triangles, const std::vector<size_t>& nodeTriangles)
 		{
-			// If we intersect, find the distance to the closest triangle in this node (if any).
+			// Find the first triangle in this node the point lies on (if any).
 
-			for (const auto& triangle : triangles)
+			for (const size_t triangle : nodeTriangles)
 			{
-				const auto& [p0, p1, p2] = triangle;
-
-				const Vertex& v0 = vertices[p0];
-				const Vertex& v1 = vertices[p1];
-				const Vertex& v2 = vertices[p2];
+				const auto& [p0, p1, p2] = triangles[triangle];
 
-				if (! pointOn(position, v0, v1, v2))
+				if (! pointOn(position, vertices[p0], vertices[p1], vertices[p2]))
 					continue;
 
-				const Vector mix = interpolate(position, v0, v1, v2);
-
-				normal		= normalAt(v0, v1, v2, mix);
-				tangent		= (v1.position - v0.position).unit();
-				bitangent	= (v2.position - v1.position).unit();
-				uv			= uvAt(v0, v1, v2, mix);
-
-				found = true;
+				found = triangle;
 				return;
 			}
 		});
 
-	if (! found)
-	{
-		assert(false);
-
-		normal		= StandardVectors::kUnitZ;
-		tangent		= StandardVectors::kUnitY;
-		bitangent	= StandardVectors::kUnitX;
-		uv			= StandardVectors::kZero;
-	}
+	return found;
 }
 
 Vector MeshObject::normalAt(const Vertex& v0, const Vertex& v1, const Vertex& v2, const Vector& mix) const
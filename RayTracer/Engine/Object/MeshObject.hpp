@@ -4,6 +4,8 @@
 #include "Engine/Object.hpp"
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 class Material;
 
@@ -17,11 +19,17 @@ public:
 								~MeshObject() override = default;
 
 // Object i/f:
+public:
+	std::vector<SurfaceTriangle>	surfaceTriangles() const override;
+	std::optional<size_t>			surfaceTriangleAt(const Vector& position) const override;
+
 protected:
 	double						intersectWith(const Ray& ray) const override;
 	void						getIntersectionProperties(const Vector& direction, const Vector& position, Vector& normal, Vector& tangent, Vector& bitangent, Vector& uv) const override;
 
 private:
+	std::optional<size_t>		triangleAt(const Vector& position) const;
+
 	Vector						normalAt(const Vertex& v0, const Vertex& v1, const Vertex& v2, const Vector& mix) const;
 	Vector						uvAt(const Vertex& v0, const Vertex& v1, const Vertex& v2, const Vector& mix) const;
 
@@ -0,0 +1,156 @@
+#include "Engine/PathGuide.hpp"
+
+#include "Engine/Scene.hpp"
+#include "Engine/SpatialGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace
+{
+	// The cells are sized so that this many span the largest dimension of the scene's bounds.
+	constexpr double kCellsAcrossScene		= 16;
+
+	// Each record is stored in units of 2^-16, and capped, so that the sums can't overflow.
+	constexpr double kRecordScale			= 65536;
+	constexpr double kMaxRecord				= 1e4;
+
+	// A cell needs this many records before it's trusted to guide, and even then keeps some
+	// chance of choosing every direction, in case the light from one was missed.
+	constexpr uint64_t kMinRecords			= 128;
+	constexpr double kUniformFraction		= 0.1;
+}
+
+PathGuide::PathGuide()
+	: m_records(kNumRecords)
+	, m_distributions(kNumCells)
+{
+
+}
+
+void PathGuide::reset(const Scene& scene)
+{
+	m_cellSize = SpatialGrid::CellSize(scene.objects, kCellsAcrossScene);
+
+	for (auto& record : m_records)
+		record.store(0, std::memory_order_relaxed);
+
+	std::fill(m_distributions.begin(), m_distributions.end(), Distribution());
+}
+
+void PathGuide::update()
+{
+	for (size_t cell = 0; cell < kNumCells; cell++)
+	{
+		const auto* cellRecords = &m_records[cell * (kNumBins + 1)];
+		Distribution& distribution = m_distributions[cell];
+
+		uint64_t total = 0;
+		for (size_t bin = 0; bin < kNumBins; bin++)
+			total += cellRecords[bin].load(std::memory_order_relaxed);
+
+		distribution.trained = total > 0 && cellRecords[kNumBins].load(std::memory_order_relaxed) >= kMinRecords;
+		if (! distribution.trained)
+			continue;
+
+		double sum = 0;
+
+		for (size_t bin = 0; bin < kNumBins; bin++)
+		{
+			sum += ((1 - kUniformFraction) * static_cast<double>(cellRecords[bin].load(std::memory_order_relaxed)) / static_cast<double>(total)) + (kUniformFraction / kNumBins);
+			distribution.cdf[bin] = static_cast<float>(sum);
+		}
+
+		distribution.cdf.back() = 1;
+	}
+}
+
+std::vector<uint64_t> PathGuide::records() const
+{
+	std::vector<uint64_t> records(kNumRecords);
+
+	for (size_t i = 0; i < kNumRecords; i++)
+		records[i] = m_records[i].load(std::memory_order_relaxed);
+
+	return records;
+}
+
+void PathGuide::restore(std::span<const uint64_t> records)
+{
+	for (size_t i = 0; i < kNumRecords && i < records.size(); i++)
+		m_records[i].store(records[i], std::memory_order_relaxed);
+
+	update();
+}
+
+void PathGuide::record(const Vector& position, const Vector& normal, const Vector& direction, double radiance)
+{
+	// The light is weighted by the cosine of its angle to the surface, as the surface's response
+	// to it is, so that grazing light the surface hardly reflects isn't worth guiding towards.
+	const double weighted = radiance * std::abs(direction.dotProduct(normal));
+
+	if (! (weighted >= 0))
+		return;
+
+	auto* cellRecords = &m_records[cell(position) * (kNumBins + 1)];
+
+	cellRecords[Bin(direction)].fetch_add(static_cast<uint64_t>(std::min(weighted, kMaxRecord) * kRecordScale), std::memory_order_relaxed);
+	cellRecords[kNumBins].fetch_add(1, std::memory_order_relaxed);
+}
+
+const PathGuide::Distribution* PathGuide::distribution(const Vector& position) const
+{
+	const Distribution& distribution = m_distributions[cell(position)];
+
+	return distribution.trained ? &distribution : nullptr;
+}
+
+Vector PathGuide::Sample(const Distribution& distribution, double u, double v)
+{
+	// Pick a bin in proportion to its probability, then reuse where u fell within the bin's
+	// range of the cdf to place the direction within it.
+	const size_t bin = std::min<size_t>(std::upper_bound(distribution.cdf.begin(), distribution.cdf.end(), u) - distribution.cdf.begin(), kNumBins - 1);
+
+	const double lower	= bin ? static_cast<double>(distribution.cdf[bin - 1]) : 0;
+	const double upper	= distribution.cdf[bin];
+	const double offset	= std::clamp((u - lower) / (upper - lower), 0.0, 1.0);
+
+	// The bins are equal areas of a cylinder wrapped around the sphere (and so of the sphere):
+	// rows by the direction's z, and columns by its angle around z.
+	const double z			= 1 - (2 * ((bin / kResolution) + offset) / kResolution);
+	const double radius		= std::sqrt(std::max(0.0, 1 - (z * z)));
+	const double rotation	= 2 * std::numbers::pi * ((bin % kResolution) + v) / kResolution;
+
+	return Vector(radius * std::cos(rotation), radius * std::sin(rotation), z);
+}
+
+double PathGuide::Pdf(const Distribution& distribution, const Vector& direction)
+{
+	const size_t bin = Bin(direction);
+	const double probability = static_cast<double>(distribution.cdf[bin]) - (bin ? static_cast<double>(distribution.cdf[bin - 1]) : 0);
+
+	return probability * kNumBins / (4 * std::numbers::pi);
+}
+
+double PathGuide::CombinedPdf(const Distribution& distribution, const Vector& direction, double materialPdf)
+{
+	return (kGuidedFraction * Pdf(distribution, direction)) + ((1 - kGuidedFraction) * materialPdf);
+}
+
+size_t PathGuide::Bin(const Vector& direction)
+{
+	const double rotation = std::atan2(direction.y(), direction.x());
+
+	const size_t row	= static_cast<size_t>(std::clamp((1 - direction.z()) / 2, 0.0, 1.0) * kResolution);
+	const size_t column	= static_cast<size_t>(((rotation < 0 ? rotation + (2 * std::numbers::pi) : rotation) / (2 * std::numbers::pi)) * kResolution);
+
+	return (std::min(row, kResolution - 1) * kResolution) + std::min(column, kResolution - 1);
+}
+
+size_t PathGuide::cell(const Vector& position) const
+{
+	// Cells that hash to the same slot share their records, which only makes guiding less
+	// effective there.
+	return static_cast<size_t>(SpatialGrid::Hash(position, m_cellSize) % kNumCells);
+}
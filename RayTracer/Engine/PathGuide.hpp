@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Engine/Vector.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+struct Scene;
+
+// Learns where the light arriving at surfaces comes from, so that scattered rays can be steered
+// towards it (in the spirit of Muller et al., "Practical Path Guiding for Efficient Light-Transport
+// Simulation"). Space is divided into a hashed grid of cells, each with a histogram over the
+// directions that light arrives from, binned by equal areas of the sphere.
+//
+// Every path records the light its scattered rays bring back as the render goes on, and between
+// passes the records are turned into distributions to sample the next pass's rays from. The
+// records are summed as fixed point integers, so they come out the same whatever order the
+// threads add them in, and the render remains identical however its work is split up.
+class PathGuide
+{
+public:
+	// Where a cell's distribution is trained, the proportion of scattered rays chosen from it
+	// rather than by the material.
+	static inline constexpr double kGuidedFraction		= 0.5;
+
+	static inline constexpr size_t kResolution			= 16;
+	static inline constexpr size_t kNumBins				= kResolution * kResolution;
+	static inline constexpr size_t kNumCells			= 4096;
+
+	// The records of each cell: the sum for each bin, followed by the number of records.
+	static inline constexpr size_t kNumRecords			= kNumCells * (kNumBins + 1);
+
+	struct Distribution
+	{
+		bool							trained = false;
+		std::array<float, kNumBins>		cdf = {};
+	};
+
+									PathGuide();
+
+	// Forgets everything learned, sizing the cells to suit the scene.
+	void							reset(const Scene& scene);
+
+	// Rebuilds the distributions from everything recorded so far. Mustn't be called while
+	// any thread might be sampling the distributions.
+	void							update();
+
+	std::vector<uint64_t>			records() const;
+	void							restore(std::span<const uint64_t> records);
+
+	// Records the light arriving at a surface from a direction, divided by the pdf the
+	// direction was chosen with. Safe to call from any number of threads at once.
+	void							record(const Vector& position, const Vector& normal, const Vector& direction, double radiance);
+
+	// The distribution for the cell a position lies in, or null if it hasn't been trained.
+	const Distribution*				distribution(const Vector& position) const;
+
+	static Vector					Sample(const Distribution& distribution, double u, double v);
+	static double					Pdf(const Distribution& distribution, const Vector& direction);
+
+	// The pdf of a direction when scattered rays are chosen from the distribution or by the
+	// material, given the pdf of the material choosing it.
+	static double					CombinedPdf(const Distribution& distribution, const Vector& direction, double materialPdf);
+
+private:
+	static size_t					Bin(const Vector& direction);
+
+	size_t							cell(const Vector& position) const;
+
+private:
+	double							m_cellSize = 1;
+
+	std::vector<std::atomic<uint64_t>>	m_records;
+	std::vector<Distribution>		m_distributions;
+};
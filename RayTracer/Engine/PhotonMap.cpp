@@ -0,0 +1,412 @@
+#include "Engine/PhotonMap.hpp"
+
+#include "Engine/Material.hpp"
+#include "Engine/Object.hpp"
+#include "Engine/Random.hpp"
+#include "Engine/Ray.hpp"
+#include "Engine/Sampling.hpp"
+#include "Engine/Scene.hpp"
+#include "Engine/SpatialGrid.hpp"
+
+#include <bit>
+#include <numbers>
+
+namespace
+{
+	constexpr uint64_t kRandomSeed				= 0x9407049407049407ull;
+
+	// Photons are shot in chunks, which are shared out between the threads.
+	constexpr size_t kPhotonsPerChunk			= 4096;
+
+	// The most photons kept from the passes already shot, for when they're rendered again;
+	// at 36 bytes each, around 150 MB of them.
+	constexpr size_t kMaxCachedPhotons			= 1u << 22;
+
+	// The first pass's radius is chosen so that, were every photon to land over an area the
+	// size of the specular objects, this many would be gathered around each hit. It then
+	// shrinks with every pass, at a rate set by this (between 0 and 1; smaller is faster).
+	constexpr double kInitialPhotonsPerEstimate	= 32;
+	constexpr double kRadiusReduction			= 2.0 / 3.0;
+
+	// Half of the photons are aimed at the lights, and the rest take cosine weighted directions.
+	constexpr double kLightSampledFraction		= 0.5;
+
+	double SphereArea(double radius)
+	{
+		return 4 * std::numbers::pi * radius * radius;
+	}
+
+	// The distances along a ray at which it enters and leaves a sphere, if it meets it at all.
+	bool IntersectSphere(const Vector& position, const Vector& direction, const Vector& center, double radius, double& entry, double& exit)
+	{
+		const Vector	offset			= position - center;
+		const double	halfB			= offset.dotProduct(direction);
+		const double	discriminant	= (halfB * halfB) - (offset.lengthSquared() - (radius * radius));
+
+		if (discriminant < 0)
+			return false;
+
+		entry	= -halfB - std::sqrt(discriminant);
+		exit	= -halfB + std::sqrt(discriminant);
+		return true;
+	}
+}
+
+PhotonMap::PhotonMap(size_t photonsPerPass)
+	: m_photonsPerPass(photonsPerPass)
+{
+
+}
+
+bool PhotonMap::beginPass(const Scene& scene, uint32_t pass)
+{
+	// Photons are aimed at the spheres bounding the specular objects (those that don't have
+	// lights sampled), as only the light that passes through them makes caustics.
+	m_targets.clear();
+	m_targetArea = 0;
+
+	for (const auto& object : scene.objects)
+	{
+		const Material& material = object->material();
+		const BoundingBox& bounds = object->boundingBox();
+
+		if (material.isLight() || material.canSampleLights() || ! std::isfinite(bounds.size().lengthSquared()))
+			continue;
+
+		const Target target{ .center = (bounds.lower() + bounds.upper()) / 2, .radius = bounds.size().length() / 2 };
+
+		m_targets.push_back(target);
+		m_targetArea += SphereArea(target.radius);
+	}
+
+	m_chunks.clear();
+	m_nextChunk = 0;
+	m_shotChunks = 0;
+	m_ready = true;
+
+	if (m_targets.empty() || ! m_photonsPerPass)
+	{
+		m_uncached = Pass();
+		m_pass = &m_uncached;
+		return true;
+	}
+
+	if (const auto cached = m_passes.find(pass); cached != m_passes.end())
+	{
+		m_pass = &cached->second;
+		return true;
+	}
+
+	double radiusSquared = kInitialPhotonsPerEstimate * m_targetArea / (std::numbers::pi * static_cast<double>(m_photonsPerPass));
+	for (uint32_t i = 1; i <= pass; i++)
+		radiusSquared *= (i + kRadiusReduction) / (i + 1);
+
+	const double radius = std::sqrt(radiusSquared);
+
+	m_shootingPass	= pass;
+	m_shooting		= Pass{ .radius = radius, .cellSize = 2 * radius, .photons = {}, .bucketStarts = {} };
+
+	m_chunks.resize((m_photonsPerPass + kPhotonsPerChunk - 1) / kPhotonsPerChunk);
+	m_ready = false;
+
+	return false;
+}
+
+bool PhotonMap::shootChunk(const Scene& scene)
+{
+	const size_t chunk = m_nextChunk++;
+
+	if (chunk >= m_chunks.size())
+		return false;
+
+	const size_t first = chunk * kPhotonsPerChunk;
+
+	m_chunks[chunk] = shoot(scene, m_shootingPass, first, std::min(kPhotonsPerChunk, m_photonsPerPass - first));
+
+	// Whichever thread shoots the last chunk joins them all in order, so the map doesn't depend
+	// on which thread shot which chunk.
+	if (++m_shotChunks == m_chunks.size())
+	{
+		std::vector<Photon> photons;
+		for (auto& shotChunk : m_chunks)
+		{
+			photons.insert(photons.end(), shotChunk.begin(), shotChunk.end());
+			shotChunk = {};
+		}
+
+		store(std::move(photons));
+
+		if (m_cachedPhotons + m_shooting.photons.size() <= kMaxCachedPhotons)
+		{
+			m_cachedPhotons += m_shooting.photons.size();
+			m_pass = &(m_passes[m_shootingPass] = std::move(m_shooting));
+		}
+		else
+		{
+			m_uncached = std::move(m_shooting);
+			m_pass = &m_uncached;
+		}
+
+		m_ready = true;
+	}
+
+	return true;
+}
+
+bool PhotonMap::carries(const Ray& ray, double distance, CausticPath causticPath) const
+{
+	if (causticPath != CausticPath::Specular)
+		return false;
+
+	// Photons leave the light towards a target, and the path's ray runs the other way, so the
+	// photons carry the light if the ray leaves a target sphere before it reaches the light.
+	for (const auto& target : m_targets)
+	{
+		double entry, exit;
+
+		if (IntersectSphere(ray.position(), ray.direction(), target.center, target.radius, entry, exit) && exit > 0 && exit < distance)
+			return true;
+	}
+
+	return false;
+}
+
+std::vector<PhotonMap::Photon> PhotonMap::shoot(const Scene& scene, uint32_t pass, size_t first, size_t count) const
+{
+	std::vector<Photon> photons;
+
+	for (size_t index = first; index < first + count; index++)
+	{
+		// Every photon has its own random sequence, apart from those of the camera's samples,
+		// with the choice of where it starts taking the place of the camera's choices.
+		Random::Start(nullptr, static_cast<uint32_t>(index), pass, 0, kRandomSeed);
+
+		const auto [u, v]			= Random::Sample2D(Random::CameraDimension::Pixel);
+		const auto [pick, select]	= Random::Sample2D(Random::CameraDimension::Lens);
+
+		// Pick a target in proportion to its area, and a point on its sphere.
+		double remainingArea = pick * m_targetArea;
+
+		size_t targetIndex = 0;
+		while (targetIndex + 1 < m_targets.size() && (remainingArea -= SphereArea(m_targets[targetIndex].radius)) > 0)
+			targetIndex++;
+
+		const Target& target = m_targets[targetIndex];
+
+		const Vector outwards	= Sampling::UniformSphere(u, v);
+		const Vector start		= target.center + (outwards * target.radius);
+
+		// Then the direction the light arrives from. Half of the photons take a cosine weighted
+		// direction, which can reach anything that emits light, and half sample the lights as a
+		// surface there would, which finds small lights far more often.
+		Random::SetBounce(0);
+
+		const bool lightSampled = select < kLightSampledFraction;
+
+		Vector towardsLight;
+		const Light* sampledLight = nullptr;
+
+		if (lightSampled)
+		{
+			const auto sample = scene.lights.sample(start, outwards);
+			if (! sample)
+				continue;
+
+			towardsLight = sample->direction;
+			sampledLight = sample->light;
+		}
+		else
+		{
+			const auto [s, t] = Random::Sample2D(Random::BounceDimension::Scatter);
+
+			towardsLight = Sampling::Frame(outwards).toWorld(Sampling::CosineHemisphere(s, t));
+		}
+
+		if (towardsLight.dotProduct(outwards) <= 0)
+			continue;
+
+		// The photon comes from whatever the line meets outside the sphere, if that emits light.
+		// Like shadow rays, a light sample only counts if it reaches the light it was aimed at.
+		const Ray backwards(start, towardsLight);
+
+		double emitterDistance;
+		const Object* emitter = backwards.closestIntersection(scene, emitterDistance);
+		const Light* light = nullptr;
+
+		Color flux;
+
+		if (emitter)
+		{
+			if (! emitter->material().isLight())
+				continue;
+
+			const Vector position = backwards.at(emitterDistance);
+
+			Vector normal;
+			Vector uv;
+			Material& material = emitter->getSurfaceProperties(backwards, position, normal, uv);
+
+			light	= scene.lights.find(*emitter, position);
+			flux	= material.emit(backwards.direction(), position, normal, uv);
+
+			if (lightSampled && (! light || light != sampledLight))
+				continue;
+		}
+		else
+		{
+			emitterDistance	= Ray::kNoIntersection;
+			flux			= backwards.background(scene);
+
+			if (lightSampled && sampledLight)
+				continue;
+		}
+
+		if (flux == Color())
+			continue;
+
+		const Vector direction = towardsLight.inverted();
+		Ray ray(start, direction);
+
+		double distance;
+		const Object* object = ray.closestIntersection(scene, distance);
+
+		if (! object)
+			continue;
+
+		// The same line could have been picked through any target it enters between the light
+		// and the first surface it reaches, by either way of choosing its direction, so the
+		// photon's light is divided by the sum of the densities of the line being picked each
+		// way. Lines are measured by the area they cross a surface at, times the cosine of the
+		// angle they cross it at, over their directions.
+		double density = 0;
+
+		for (size_t i = 0; i < m_targets.size(); i++)
+		{
+			double entry = 0, exit;
+
+			if (i != targetIndex && ! (IntersectSphere(start, direction, m_targets[i].center, m_targets[i].radius, entry, exit) && entry > -emitterDistance && entry < distance))
+				continue;
+
+			const Vector entryPoint		= start + (direction * entry);
+			const Vector entryNormal	= (i == targetIndex) ? outwards : (entryPoint - m_targets[i].center) / m_targets[i].radius;
+			const double cosAngle		= towardsLight.dotProduct(entryNormal);
+
+			if (cosAngle <= 0)
+				continue;
+
+			// Emitters that aren't lights (or the background) can only be reached by the
+			// cosine weighted directions.
+			const double lightPdf = (emitter && ! light) ? 0 : scene.lights.pdf(light, entryPoint, entryNormal, towardsLight);
+
+			density += ((1 - kLightSampledFraction) / std::numbers::pi) + (kLightSampledFraction * lightPdf / cosAngle);
+		}
+
+		if (density <= 0)
+			continue;
+
+		flux *= m_targetArea / (density * static_cast<double>(m_photonsPerPass));
+
+		// Follow the photon through the specular surfaces, storing it where it lands after
+		// passing through at least one of them.
+		for (uint32_t bounces = 0;;)
+		{
+			const Vector position = ray.at(distance);
+
+			Vector normal;
+			Vector uv;
+			Material& material = object->getSurfaceProperties(ray, position, normal, uv);
+
+			if (material.isLight())
+				break;
+
+			if (material.canSampleLights())
+			{
+				if (bounces)
+				{
+					photons.push_back(
+						{
+							.position	= { static_cast<float>(position.x()), static_cast<float>(position.y()), static_cast<float>(position.z()) },
+							.direction	= { static_cast<float>(ray.direction().x()), static_cast<float>(ray.direction().y()), static_cast<float>(ray.direction().z()) },
+							.flux		= { static_cast<float>(flux.red()), static_cast<float>(flux.green()), static_cast<float>(flux.blue()) },
+						});
+				}
+
+				break;
+			}
+
+			Random::SetBounce(++bounces);
+
+			Color attenuation;
+			double pdf;
+			const auto scattered = material.scatter(ray.direction(), position, normal, uv, attenuation, pdf);
+
+			if (! scattered || pdf <= 0)
+				break;
+
+			attenuation *= material.scatterPdf(ray.direction(), position, normal, scattered->direction()) / pdf;
+
+			// Russian roulette termination, as for paths from the camera.
+			if (bounces > 3)
+			{
+				const double survivalProbability = std::min(attenuation.average(), 0.90);
+
+				if (Random::Sample(Random::BounceDimension::Roulette) > survivalProbability)
+					break;
+
+				attenuation /= survivalProbability;
+			}
+
+			flux *= attenuation;
+			ray = *scattered;
+
+			object = ray.closestIntersection(scene, distance);
+			if (! object)
+				break;
+		}
+	}
+
+	return photons;
+}
+
+void PhotonMap::store(std::vector<Photon> photons)
+{
+	// Sort the photons by bucket (a counting sort, as there are as many buckets as photons),
+	// so that each bucket's photons lie together.
+	const size_t numBuckets = std::bit_ceil(std::max<size_t>(photons.size(), 1));
+
+	m_shooting.bucketStarts.assign(numBuckets + 1, 0);
+
+	std::vector<size_t> buckets(photons.size());
+
+	for (size_t i = 0; i < photons.size(); i++)
+	{
+		const auto& position = photons[i].position;
+
+		buckets[i] = m_shooting.bucket(
+			m_shooting.cellCoordinate(static_cast<double>(position[0])),
+			m_shooting.cellCoordinate(static_cast<double>(position[1])),
+			m_shooting.cellCoordinate(static_cast<double>(position[2])));
+
+		m_shooting.bucketStarts[buckets[i] + 1]++;
+	}
+
+	for (size_t i = 0; i < numBuckets; i++)
+		m_shooting.bucketStarts[i + 1] += m_shooting.bucketStarts[i];
+
+	std::vector<uint32_t> next(m_shooting.bucketStarts.begin(), m_shooting.bucketStarts.end() - 1);
+
+	m_shooting.photons.resize(photons.size());
+
+	for (size_t i = 0; i < photons.size(); i++)
+		m_shooting.photons[next[buckets[i]]++] = photons[i];
+}
+
+size_t PhotonMap::Pass::bucket(int64_t x, int64_t y, int64_t z) const
+{
+	return static_cast<size_t>(SpatialGrid::Hash(x, y, z)) & (bucketStarts.size() - 2);
+}
+
+int64_t PhotonMap::Pass::cellCoordinate(double value) const
+{
+	return SpatialGrid::Coordinate(value, cellSize);
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "Engine/Color.hpp"
+#include "Engine/Vector.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+class Ray;
+
+struct Scene;
+
+// Caustics: light that reaches a diffuse (or glossy) surface after being reflected or refracted
+// by specular surfaces, such as the bright spots focused by glass spheres. Paths traced from the
+// camera can only find these by scattering through the specular surfaces and happening to hit a
+// light, so they show up as fireflies that take an age to converge.
+//
+// Instead, each pass shoots photons from the lights at the specular objects, and stores where
+// they land once they've passed through them. A surface's caustics are then estimated from the
+// photons within a radius of each hit on it, and paths no longer count the light they reach
+// through specular surfaces from there. The radius shrinks with every pass (Knaus and Zwicker,
+// "Progressive Photon Mapping: A Probabilistic Approach"), so that the average over all passes
+// converges on the right answer, as it would with more samples.
+//
+// The photons are stored in a hashed grid of cells twice the radius in size, sorted by cell,
+// so only the photons of the eight cells around a hit need to be checked.
+//
+// The photons are shot by the renderer's own threads, as the first stage of each pass, and
+// each pass's photons are kept once shot (up to a limit), so rendering the same passes again
+// (as a worker does for every tile, or the viewer after the camera moves) reuses them.
+class PhotonMap
+{
+public:
+	// How a path's rays relate to the caustics gathered from the map.
+	enum class CausticPath : uint8_t
+	{
+		None,
+		Leaving,	// The ray leaves a surface that gathers its caustics from the map
+		Specular,	// The ray has only been reflected or refracted by specular surfaces since
+	};
+
+	explicit						PhotonMap(size_t photonsPerPass);
+
+	// Makes the photons for a pass of the render the ones gathered, in place of those of the
+	// previous pass. Returns whether they're ready; if they weren't kept from an earlier render
+	// of the pass, shootChunk must be called until they are.
+	bool							beginPass(const Scene& scene, uint32_t pass);
+
+	// Shoots the next chunk of the pass's photons, returning false once there are none left to
+	// shoot. Any number of threads can shoot chunks at once, and the photons only depend on the
+	// pass, not on which thread shot which chunk. The map is built as the last chunk is shot.
+	bool							shootChunk(const Scene& scene);
+	bool							hasChunksToShoot() const	{ return m_nextChunk < m_chunks.size(); }
+	bool							ready() const				{ return m_ready; }
+
+	double							radius() const				{ return m_pass->radius; }
+
+	// Whether the light a path reaches along a ray, at the given distance, has already been
+	// carried to the surface it left by the photons; it's then left out of the path's light.
+	bool							carries(const Ray& ray, double distance, CausticPath causticPath) const;
+
+	// Calls function(direction, flux) for every photon within the radius of a position, with
+	// the direction the photon was travelling in when it landed.
+	template <typename Function>
+	void							gather(const Vector& position, const Function& function) const;
+
+private:
+	struct Photon
+	{
+		std::array<float, 3>		position;
+		std::array<float, 3>		direction;
+		std::array<float, 3>		flux;
+	};
+
+	// A sphere around a specular object; photons are aimed at these.
+	struct Target
+	{
+		Vector						center;
+		double						radius = 0;
+	};
+
+	// The photons of a pass, sorted by bucket, and where each bucket's photons start.
+	struct Pass
+	{
+		double						radius = 0;
+		double						cellSize = 1;
+
+		std::vector<Photon>			photons;
+		std::vector<uint32_t>		bucketStarts;
+
+		size_t						bucket(int64_t x, int64_t y, int64_t z) const;
+		int64_t						cellCoordinate(double value) const;
+	};
+
+	std::vector<Photon>				shoot(const Scene& scene, uint32_t pass, size_t first, size_t count) const;
+	void							store(std::vector<Photon> photons);
+
+private:
+	size_t							m_photonsPerPass = 0;
+
+	std::vector<Target>				m_targets;
+	double							m_targetArea = 0;
+
+	// The passes shot so far, and the pass being gathered from; passes that don't fit within
+	// the limit are only kept until the next pass replaces them.
+	std::map<uint32_t, Pass>		m_passes;
+	size_t							m_cachedPhotons = 0;
+	Pass							m_uncached;
+	const Pass*						m_pass = &m_uncached;
+
+	// The pass being shot, with each chunk's photons kept apart until they're all shot.
+	uint32_t						m_shootingPass = 0;
+	Pass							m_shooting;
+	std::vector<std::vector<Photon>>	m_chunks;
+	std::atomic<size_t>				m_nextChunk = 0;
+	std::atomic<size_t>				m_shotChunks = 0;
+	std::atomic<bool>				m_ready = true;
+};
+
+template <typename Function>
+void PhotonMap::gather(const Vector& position, const Function& function) const
+{
+	const Pass& pass = *m_pass;
+
+	if (pass.photons.empty())
+		return;
+
+	// With cells twice the radius in size, the sphere around the position overlaps at most
+	// two cells along each axis. Cells that share a bucket are only searched once.
+	const std::array<int64_t, 3> lower	= { pass.cellCoordinate(position.x() - pass.radius), pass.cellCoordinate(position.y() - pass.radius), pass.cellCoordinate(position.z() - pass.radius) };
+	const std::array<int64_t, 3> upper	= { pass.cellCoordinate(position.x() + pass.radius), pass.cellCoordinate(position.y() + pass.radius), pass.cellCoordinate(position.z() + pass.radius) };
+
+	std::array<size_t, 8> searched;
+	size_t numSearched = 0;
+
+	const double radiusSquared = pass.radius * pass.radius;
+
+	for (int64_t z = lower[2]; z <= upper[2]; z++)
+	{
+		for (int64_t y = lower[1]; y <= upper[1]; y++)
+		{
+			for (int64_t x = lower[0]; x <= upper[0]; x++)
+			{
+				const size_t index = pass.bucket(x, y, z);
+
+				if (std::find(searched.begin(), searched.begin() + numSearched, index) != searched.begin() + numSearched)
+					continue;
+
+				searched[numSearched++] = index;
+
+				for (uint32_t i = pass.bucketStarts[index]; i < pass.bucketStarts[index + 1]; i++)
+				{
+					const Photon& photon = pass.photons[i];
+
+					const double dx = static_cast<double>(photon.position[0]) - position.x();
+					const double dy = static_cast<double>(photon.position[1]) - position.y();
+					const double dz = static_cast<double>(photon.position[2]) - position.z();
+
+					if ((dx * dx) + (dy * dy) + (dz * dz) > radiusSquared)
+						continue;
+
+					function(
+						Vector(static_cast<double>(photon.direction[0]), static_cast<double>(photon.direction[1]), static_cast<double>(photon.direction[2])),
+						Color(static_cast<double>(photon.flux[0]), static_cast<double>(photon.flux[1]), static_cast<double>(photon.flux[2])));
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,119 @@
+#include "Engine/RadianceCache.hpp"
+
+#include "Engine/SpatialGrid.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+	// Each record is stored in units of 2^-16, and capped, so that the sums can't overflow.
+	constexpr double kRecordScale			= 65536;
+	constexpr double kMaxRecord				= 1e3;
+
+	// A cell needs this many records before its average is trusted.
+	constexpr uint64_t kMinRecords			= 64;
+
+	// The records of a cell that nothing has been recorded in.
+	constexpr std::array<uint64_t, RadianceCache::kRecordsPerCell> kEmptyRecords = { 0, 0, 0, 0, std::numeric_limits<uint64_t>::max(), 0 };
+}
+
+RadianceCache::RadianceCache(const std::vector<std::shared_ptr<Object>>& objects, double cellsAcrossScene)
+	: m_cellSize(SpatialGrid::CellSize(objects, cellsAcrossScene))
+	, m_records(kNumRecords)
+	, m_averages(kNumCells)
+{
+	for (size_t i = 0; i < kNumRecords; i++)
+		m_records[i].store(kEmptyRecords[i % kRecordsPerCell], std::memory_order_relaxed);
+}
+
+void RadianceCache::update()
+{
+	for (size_t cell = 0; cell < kNumCells; cell++)
+	{
+		const auto* cellRecords = &m_records[cell * kRecordsPerCell];
+		Average& average = m_averages[cell];
+
+		const uint64_t count = cellRecords[3].load(std::memory_order_relaxed);
+
+		average.trained = count >= kMinRecords && cellRecords[4].load(std::memory_order_relaxed) == cellRecords[5].load(std::memory_order_relaxed);
+		if (! average.trained)
+			continue;
+
+		const auto channel = [&](size_t index) { return static_cast<double>(cellRecords[index].load(std::memory_order_relaxed)) / (kRecordScale * static_cast<double>(count)); };
+
+		average.key			= cellRecords[4].load(std::memory_order_relaxed);
+		average.radiance	= Color(channel(0), channel(1), channel(2));
+	}
+}
+
+void RadianceCache::reset()
+{
+	restore({});
+}
+
+std::vector<uint64_t> RadianceCache::records() const
+{
+	std::vector<uint64_t> records(kNumRecords);
+
+	for (size_t i = 0; i < kNumRecords; i++)
+		records[i] = m_records[i].load(std::memory_order_relaxed);
+
+	return records;
+}
+
+void RadianceCache::restore(std::span<const uint64_t> records)
+{
+	for (size_t i = 0; i < kNumRecords; i++)
+		m_records[i].store(i < records.size() ? records[i] : kEmptyRecords[i % kRecordsPerCell], std::memory_order_relaxed);
+
+	update();
+}
+
+void RadianceCache::record(const Vector& position, const Vector& normal, const Color& radiance)
+{
+	if (! (radiance.red() >= 0 && radiance.green() >= 0 && radiance.blue() >= 0))
+		return;
+
+	const uint64_t cellKey = key(position, normal);
+
+	auto* cellRecords = &m_records[(cellKey % kNumCells) * kRecordsPerCell];
+
+	const auto scaled = [](double value) { return static_cast<uint64_t>(std::min(value, kMaxRecord) * kRecordScale); };
+
+	cellRecords[0].fetch_add(scaled(radiance.red()), std::memory_order_relaxed);
+	cellRecords[1].fetch_add(scaled(radiance.green()), std::memory_order_relaxed);
+	cellRecords[2].fetch_add(scaled(radiance.blue()), std::memory_order_relaxed);
+	cellRecords[3].fetch_add(1, std::memory_order_relaxed);
+
+	// The smallest and largest keys come out the same whatever order the records are made in,
+	// and only match if every record in the slot was for the same cell.
+	for (uint64_t smallest = cellRecords[4].load(std::memory_order_relaxed); cellKey < smallest && ! cellRecords[4].compare_exchange_weak(smallest, cellKey, std::memory_order_relaxed);)
+		;
+
+	for (uint64_t largest = cellRecords[5].load(std::memory_order_relaxed); cellKey > largest && ! cellRecords[5].compare_exchange_weak(largest, cellKey, std::memory_order_relaxed);)
+		;
+}
+
+const Color* RadianceCache::lookup(const Vector& position, const Vector& normal) const
+{
+	const uint64_t cellKey = key(position, normal);
+	const Average& average = m_averages[cellKey % kNumCells];
+
+	return average.trained && average.key == cellKey ? &average.radiance : nullptr;
+}
+
+uint64_t RadianceCache::key(const Vector& position, const Vector& normal) const
+{
+	// Surfaces facing different ways within a cell (the floor and walls in a corner, or either
+	// side of a thin object) are kept apart by the axis that their normal lies closest to.
+	const Vector absolute(std::abs(normal.x()), std::abs(normal.y()), std::abs(normal.z()));
+
+	const uint64_t axis	= (absolute.x() >= absolute.y() && absolute.x() >= absolute.z()) ? 0 : (absolute.y() >= absolute.z()) ? 1 : 2;
+	const double along	= axis == 0 ? normal.x() : axis == 1 ? normal.y() : normal.z();
+	const uint64_t face	= (axis * 2) + (along < 0 ? 1 : 0);
+
+	return SpatialGrid::Hash(position, m_cellSize, face);
+}
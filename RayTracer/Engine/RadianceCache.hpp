@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Engine/Color.hpp"
+#include "Engine/Vector.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+class Object;
+
+// Caches the light leaving diffuse surfaces, so that paths can stop at their second diffuse
+// hit and take the light leaving it from the cache, rather than following it any further.
+// Space is divided into a hashed grid of cells, further split by which way the surface faces,
+// each averaging the light that paths have found leaving diffuse surfaces within it.
+//
+// Every diffuse hit that's shaded records the light it sends back along its path, and between
+// passes the records are turned into the averages that the next pass looks up. Like those of
+// PathGuide, the records are summed as fixed point integers, so the render doesn't depend on
+// the order the threads add them in. Unlike the guide's, cells that hash to the same slot
+// aren't left to share it, as their light would leak between them; such slots are never used.
+//
+// The light leaving a diffuse surface doesn't depend on where it's seen from, so the viewer
+// lets the cache carry on learning from one render of a scene to the next as the camera moves
+// around it. Other renders start from an empty cache, so that they don't depend on what was
+// rendered before them. The averages are biased: the smaller the cells, the less light is
+// blurred across them, but the longer they take to fill.
+class RadianceCache
+{
+public:
+	static inline constexpr double kDefaultCellsAcrossScene	= 64;
+
+	static inline constexpr size_t kNumCells				= 1 << 18;
+
+	// The records of each cell: the sums of the red, green and blue light, the number of
+	// records, then the smallest and largest keys of the cells recorded (see key()).
+	static inline constexpr size_t kRecordsPerCell			= 6;
+	static inline constexpr size_t kNumRecords				= kNumCells * kRecordsPerCell;
+
+	// The cells are sized so that the given number span the largest dimension of the bounds of
+	// the objects.
+									RadianceCache(const std::vector<std::shared_ptr<Object>>& objects, double cellsAcrossScene);
+
+	// Rebuilds the averages from everything recorded so far. Mustn't be called while any
+	// thread might be looking them up.
+	void							update();
+
+	// Discards everything recorded so far. Like update(), mustn't be called while any thread
+	// might be using the cache.
+	void							reset();
+
+	std::vector<uint64_t>			records() const;
+	void							restore(std::span<const uint64_t> records);
+
+	// Records the light leaving a diffuse surface. Safe to call from any number of threads at once.
+	void							record(const Vector& position, const Vector& normal, const Color& radiance);
+
+	// The average light leaving diffuse surfaces in the cell a position lies in, facing the
+	// same way, or null if too little has been recorded there to rely on.
+	const Color*					lookup(const Vector& position, const Vector& normal) const;
+
+private:
+	struct Average
+	{
+		bool						trained = false;
+		uint64_t					key = 0;
+		Color						radiance;
+	};
+
+	uint64_t						key(const Vector& position, const Vector& normal) const;
+
+private:
+	double							m_cellSize = 1;
+
+	std::vector<std::atomic<uint64_t>>	m_records;
+	std::vector<Average>			m_averages;
+};
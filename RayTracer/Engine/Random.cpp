@@ -0,0 +1,67 @@
+#include "Engine/Random.hpp"
+
+namespace
+{
+	// The number of Philox calls made together, each giving the numbers for a pair of dimensions.
+	constexpr size_t kLanes = 4;
+
+	using Lanes = std::array<uint32_t, kLanes>;
+
+	// Philox for four counters at once, with the counters' words (and the results') stored one
+	// word per array, a lane for each counter. The lanes of each round are independent, which
+	// leaves the compiler free to vectorize them.
+	void PhiloxLanes(std::array<Lanes, 4>& counters, std::array<uint32_t, 2> key)
+	{
+		constexpr uint32_t kMultipliers[]	= { 0xD2511F53u, 0xCD9E8D57u };
+		constexpr uint32_t kKeyIncrements[]	= { 0x9E3779B9u, 0xBB67AE85u };
+		constexpr int kRounds				= 10;
+
+		for (int round = 0; round < kRounds; round++)
+		{
+			for (size_t lane = 0; lane < kLanes; lane++)
+			{
+				const uint64_t product0 = static_cast<uint64_t>(kMultipliers[0]) * counters[0][lane];
+				const uint64_t product1 = static_cast<uint64_t>(kMultipliers[1]) * counters[2][lane];
+
+				const uint32_t word1 = counters[1][lane];
+				const uint32_t word3 = counters[3][lane];
+
+				counters[0][lane] = static_cast<uint32_t>(product1 >> 32) ^ word1 ^ key[0];
+				counters[1][lane] = static_cast<uint32_t>(product1);
+				counters[2][lane] = static_cast<uint32_t>(product0 >> 32) ^ word3 ^ key[1];
+				counters[3][lane] = static_cast<uint32_t>(product0);
+			}
+
+			key[0] += kKeyIncrements[0];
+			key[1] += kKeyIncrements[1];
+		}
+	}
+}
+
+void Random::FillIndependent(std::span<double> values, uint32_t x, uint32_t y, uint32_t index, uint32_t firstDimension, uint64_t seed)
+{
+	const uint32_t firstPair = firstDimension / 2;
+
+	for (size_t first = 0; first < values.size(); first += kLanes * 2)
+	{
+		std::array<Lanes, 4> counters;
+
+		counters[0].fill(x);
+		counters[1].fill(y);
+		counters[2].fill(index);
+
+		for (size_t lane = 0; lane < kLanes; lane++)
+			counters[3][lane] = firstPair + static_cast<uint32_t>((first / 2) + lane);
+
+		PhiloxLanes(counters, PhiloxKey(seed));
+
+		for (size_t lane = 0; lane < kLanes && first + (lane * 2) < values.size(); lane++)
+		{
+			const size_t value = first + (lane * 2);
+
+			values[value] = ToUnitInterval(counters[0][lane], counters[1][lane]);
+			if (value + 1 < values.size())
+				values[value + 1] = ToUnitInterval(counters[2][lane], counters[3][lane]);
+		}
+	}
+}
@@ -1,24 +1,180 @@
 #pragma once
 
-#include <XoshiroCpp.hpp>
+#include "Engine/Sampler.hpp"
 
-#include <random>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
 
 namespace Random
 {
-	static inline double SignedNormal()
+	// The dimensions of a sampler's sample space that each choice is made with. The camera's
+	// choices come first, followed by a block of dimensions for each bounce along the path, so
+	// the same choice is made with the same dimension on every sample of a pixel.
+	enum class CameraDimension : uint32_t
 	{
-		thread_local XoshiroCpp::Xoroshiro128PlusPlus generator;
-		thread_local std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+		Pixel			= 0,	// 2D: position within the pixel
+		Lens			= 2,	// 2D: position on the lens aperture
+		Count			= 4,
+	};
 
-		return distribution(generator);
+	enum class BounceDimension : uint32_t
+	{
+		LightSelection	= 0,	// 1D: whether to sample the background or the other lights
+		LightPick		= 1,	// 1D: which of the other lights to sample
+		Light			= 2,	// 2D: position on (or direction towards) the sampled light
+		Scatter			= 4,	// 2D: direction of the scattered ray
+		Roulette		= 6,	// 1D: Russian roulette termination
+		GuideSelection	= 7,	// 1D: whether to scatter along a direction chosen by the path guide
+		Count			= 8,
+	};
+
+	// A stateless, counter-based generator (Salmon et al., "Parallel Random Numbers: As Easy as
+	// 1, 2, 3"). Its output is a bijective scramble of the counter under the key, so any number
+	// of any sequence can be produced directly, in any order and on any thread.
+	constexpr std::array<uint32_t, 4> Philox(std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key)
+	{
+		constexpr uint32_t kMultipliers[]	= { 0xD2511F53u, 0xCD9E8D57u };
+		constexpr uint32_t kKeyIncrements[]	= { 0x9E3779B9u, 0xBB67AE85u };
+		constexpr int kRounds				= 10;
+
+		for (int round = 0; round < kRounds; round++)
+		{
+			const uint64_t product0 = static_cast<uint64_t>(kMultipliers[0]) * counter[0];
+			const uint64_t product1 = static_cast<uint64_t>(kMultipliers[1]) * counter[2];
+
+			counter =
+				{
+					static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+					static_cast<uint32_t>(product1),
+					static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+					static_cast<uint32_t>(product0),
+				};
+
+			key[0] += kKeyIncrements[0];
+			key[1] += kKeyIncrements[1];
+		}
+
+		return counter;
+	}
+
+	constexpr std::array<uint32_t, 2> PhiloxKey(uint64_t seed)
+	{
+		return { static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32) };
+	}
+
+	// A number in [0, 1) from 53 of the bits of a pair of Philox output words.
+	constexpr double ToUnitInterval(uint32_t high, uint32_t low)
+	{
+		return ((static_cast<uint64_t>(high >> 5) << 26) | (low >> 6)) * 0x1p-53;
+	}
+
+	// An independent random number in [0, 1) for a dimension of one sample of a pixel. Each
+	// Philox call gives the numbers for a pair of dimensions.
+	constexpr double Independent(uint32_t x, uint32_t y, uint32_t index, uint32_t dimension, uint64_t seed)
+	{
+		const auto bits = Philox({ x, y, index, dimension / 2 }, PhiloxKey(seed));
+
+		return dimension % 2 ? ToUnitInterval(bits[2], bits[3]) : ToUnitInterval(bits[0], bits[1]);
+	}
+
+	// Fills values with the independent random numbers for a run of dimensions of one sample of
+	// a pixel, starting from an even dimension. The Philox calls for several pairs of dimensions
+	// are made together, so that the compiler can vectorize them.
+	void FillIndependent(std::span<double> values, uint32_t x, uint32_t y, uint32_t index, uint32_t firstDimension, uint64_t seed);
+
+	// Where the random choices of one sample of a pixel come from: the sampler's point for the
+	// sample, or (without a sampler) independent random numbers keyed by the seed, the pixel,
+	// the sample and the dimension. Either way, nothing depends on the choices made before, or
+	// on which thread traces the sample.
+	//
+	// Independent numbers are generated a block at a time: the camera's when the sample starts,
+	// and each bounce's the first time one of them is used.
+	struct Sequence
+	{
+		const Sampler*	sampler = nullptr;
+		uint64_t		seed = 0;
+		uint32_t		x = 0;
+		uint32_t		y = 0;
+		uint32_t		index = 0;
+		uint32_t		bounce = 0;
+
+		std::array<double, static_cast<size_t>(CameraDimension::Count)>	cameraSamples = {};
+		std::array<double, static_cast<size_t>(BounceDimension::Count)>	bounceSamples = {};
+		bool																bounceSamplesReady = false;
+	};
+
+	// A single sequence per thread, shared by every translation unit so that the
+	// numbers it produces are fully determined by the last call to Start().
+	inline Sequence& CurrentSequence()
+	{
+		thread_local Sequence sequence;
+
+		return sequence;
+	}
+
+	inline void Start(const Sampler* sampler, uint32_t x, uint32_t y, uint32_t index, uint64_t seed)
+	{
+		Sequence& sequence = CurrentSequence();
+
+		sequence =
+			{
+				.sampler	= sampler,
+				.seed		= seed,
+				.x			= x,
+				.y			= y,
+				.index		= index,
+			};
+
+		if (! sampler)
+			FillIndependent(sequence.cameraSamples, x, y, index, 0, seed);
+	}
+
+	inline void SetBounce(uint32_t bounce)
+	{
+		Sequence& sequence = CurrentSequence();
+
+		sequence.bounce				= bounce;
+		sequence.bounceSamplesReady	= false;
+	}
+
+	inline double Sample(CameraDimension dimension)
+	{
+		const Sequence& sequence = CurrentSequence();
+
+		if (sequence.sampler)
+			return sequence.sampler->sample(sequence.x, sequence.y, sequence.index, static_cast<uint32_t>(dimension));
+
+		return sequence.cameraSamples[static_cast<size_t>(dimension)];
+	}
+
+	inline double Sample(BounceDimension dimension)
+	{
+		Sequence& sequence = CurrentSequence();
+
+		const uint32_t firstDimension = static_cast<uint32_t>(CameraDimension::Count) + (sequence.bounce * static_cast<uint32_t>(BounceDimension::Count));
+
+		if (sequence.sampler)
+			return sequence.sampler->sample(sequence.x, sequence.y, sequence.index, firstDimension + static_cast<uint32_t>(dimension));
+
+		if (! sequence.bounceSamplesReady)
+		{
+			FillIndependent(sequence.bounceSamples, sequence.x, sequence.y, sequence.index, firstDimension, sequence.seed);
+			sequence.bounceSamplesReady = true;
+		}
+
+		return sequence.bounceSamples[static_cast<size_t>(dimension)];
 	}
 
-	static inline double UnsignedNormal()
+	// Both numbers of a pair of dimensions, in order.
+	template <typename Dimension>
+	inline std::pair<double, double> Sample2D(Dimension dimension)
 	{
-		thread_local XoshiroCpp::Xoroshiro128PlusPlus generator;
-		thread_local std::uniform_real_distribution<double> distribution(0.0, 1.0);
+		const double first	= Sample(dimension);
+		const double second	= Sample(static_cast<Dimension>(static_cast<uint32_t>(dimension) + 1));
 
-		return distribution(generator);
+		return { first, second };
 	}
 }
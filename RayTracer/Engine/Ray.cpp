@@ -1,9 +1,21 @@
 #include "Engine/Ray.hpp"
 
+#include "Engine/Material.hpp"
 #include "Engine/MathUtil.hpp"
 #include "Engine/Object.hpp"
+#include "Engine/Random.hpp"
+#include "Engine/Sampling.hpp"
 #include "Engine/Scene.hpp"
 
+namespace
+{
+	// How many bounces off mirrors and glass direct lighting previews follow.
+	constexpr uint32_t kMaxPreviewDepth	= 4;
+
+	// How many directions ambient occlusion previews test for each sample.
+	constexpr uint32_t kOcclusionRays	= 4;
+}
+
 Ray::Ray(const Vector& position, const Vector& direction)
 	: m_position(position)
 	, m_direction(direction)
@@ -12,10 +24,11 @@ Ray::Ray(const Vector& position, const Vector& direction)
 
 }
 
-Color Ray::trace(const Scene& scene, uint32_t rayDepth) const
+const Object* Ray::closestIntersection(const Scene& scene, double& closestIntersectionDistance) const
 {
-	double			closestIntersectionDistance = Ray::kNoIntersection;
-	const Object*	closestObject = nullptr;
+	closestIntersectionDistance = Ray::kNoIntersection;
+
+	const Object* closestObject = nullptr;
 
 	// Find out what the closest interested object is, ans its distance to us.
 	for (const auto& object : scene.objects)
@@ -36,18 +49,193 @@ Color Ray::trace(const Scene& scene, uint32_t rayDepth) const
 		closestObject = object.get();
 	}
 
+	return closestObject;
+}
+
+Color Ray::background(const Scene& scene) const
+{
+	Vector polarDirection = MathUtil::CartesianToPolar(m_direction);
+
+	double u = .5 + polarDirection.x();
+	double v = .5 + polarDirection.y();
+	return scene.background->sample(u, v);
+}
+
+Color Ray::trace(const Scene& scene, uint32_t rayDepth, double scatterPdf, const Vector& scatterNormal) const
+{
+	return trace(scene, rayDepth, scatterPdf, scatterNormal, PhotonMap::CausticPath::None, false, nullptr);
+}
+
+Color Ray::trace(const Scene& scene, Features& features) const
+{
+	return trace(scene, 0, 0, Vector(), PhotonMap::CausticPath::None, false, &features);
+}
+
+Color Ray::trace(const Scene& scene, uint32_t rayDepth, double scatterPdf, const Vector& scatterNormal, PhotonMap::CausticPath causticPath, bool afterDiffuse, Features* features) const
+{
+	double closestIntersectionDistance;
+	const Object* closestObject = closestIntersection(scene, closestIntersectionDistance);
+
 	if (! closestObject)
 	{
 		// We hit nothing, texture based on the scene background instead.
+		const Color backgroundColor = background(scene);
+
+		if (features)
+			*features = Features{ .albedo = backgroundColor, .normal = Vector(), .depth = 0, .object = nullptr };
 
-		Vector polarDirection = MathUtil::CartesianToPolar(m_direction);
+		if (scene.photons && scene.photons->carries(*this, kNoIntersection, causticPath))
+			return Palette::kBlack;
 
-		double u = .5 + polarDirection.x();
-		double v = .5 + polarDirection.y();
-		return scene.background->sample(u, v);
+		return backgroundColor * scene.lights.backgroundWeight(*this, scatterPdf);
 	}
 
 	// Texture based on the intersected object.
-	const auto intersectionPoint = at(closestIntersectionDistance);
-	return closestObject->illuminate(scene, *this, intersectionPoint, rayDepth + 1);
+	Material::Bounce bounce;
+	bounce.incident	= m_direction;
+	bounce.position	= at(closestIntersectionDistance);
+	bounce.rayDepth	= rayDepth + 1;
+	bounce.guide	= scene.guide.get();
+	bounce.photons	= scene.photons.get();
+
+	bounce.causticPath		= causticPath;
+	bounce.emissionWeight	= scene.lights.emissionWeight(*closestObject, bounce.position, *this, scatterNormal, scatterPdf);
+
+	if (scene.photons && closestObject->material().isLight() && scene.photons->carries(*this, closestIntersectionDistance, causticPath))
+		bounce.emissionWeight = 0;
+
+	Material& material = closestObject->getSurfaceProperties(*this, bounce.position, bounce.normal, bounce.uv);
+
+	// Past the first diffuse surface, the light leaving any other is taken from the cache where
+	// it's known, ending the path there.
+	if (scene.cache && afterDiffuse && material.isDiffuse())
+	{
+		if (const Color* radiance = scene.cache->lookup(bounce.position, bounce.normal))
+			return *radiance;
+	}
+
+	material.bounce(scene.lights, bounce);
+
+	if (features)
+		*features = Features{ .albedo = material.albedo(bounce.uv), .normal = bounce.normal, .depth = closestIntersectionDistance, .object = closestObject };
+
+	Color color = bounce.emitted;
+
+	if (bounce.lightRay)
+		color += bounce.lightWeight * scene.lights.traceEmission(scene, bounce.light, *bounce.lightRay);
+
+	if (bounce.scatterRay)
+	{
+		const Color incoming = bounce.scatterRay->trace(scene, bounce.rayDepth, bounce.scatterPdf, bounce.normal, bounce.scatterCausticPath, afterDiffuse || material.isDiffuse(), nullptr);
+
+		if (bounce.recordPdf > 0)
+			bounce.guide->record(bounce.position, bounce.normal, bounce.scatterRay->direction(), incoming.luminance() / bounce.recordPdf);
+
+		color += bounce.weight * incoming;
+	}
+
+	if (scene.cache && material.isDiffuse())
+		scene.cache->record(bounce.position, bounce.normal, color);
+
+	return color;
+}
+
+Color Ray::traceDirect(const Scene& scene, Features& features) const
+{
+	return traceDirect(scene, 0, 0, Vector(), false, &features);
+}
+
+Color Ray::traceOcclusion(const Scene& scene, double distance, Features& features) const
+{
+	features = firstHit(scene);
+
+	if (! features.object)
+		return features.albedo;
+
+	const Vector position = at(features.depth);
+	const Vector normal = features.normal.dotProduct(m_direction) > 0 ? features.normal.inverted() : features.normal;
+
+	const Sampling::Frame frame(normal);
+
+	// Testing cosine weighted directions makes the fraction left open the usual cosine
+	// weighted ambient occlusion. Each direction takes the dimensions of a bounce of its own.
+	uint32_t open = 0;
+
+	for (uint32_t ray = 0; ray < kOcclusionRays; ray++)
+	{
+		Random::SetBounce(ray + 1);
+
+		const auto [u, v] = Random::Sample2D(Random::BounceDimension::Scatter);
+
+		double hitDistance;
+		if (! Ray(position, frame.toWorld(Sampling::CosineHemisphere(u, v))).closestIntersection(scene, hitDistance) || hitDistance >= distance)
+			open++;
+	}
+
+	return features.albedo * (static_cast<double>(open) / kOcclusionRays);
+}
+
+Features Ray::firstHit(const Scene& scene) const
+{
+	double closestIntersectionDistance;
+	const Object* closestObject = closestIntersection(scene, closestIntersectionDistance);
+
+	if (! closestObject)
+		return Features{ .albedo = background(scene), .normal = Vector(), .depth = 0, .object = nullptr };
+
+	const Vector position = at(closestIntersectionDistance);
+
+	Vector normal;
+	Vector uv;
+	Material& material = closestObject->getSurfaceProperties(*this, position, normal, uv);
+
+	return Features{ .albedo = material.albedo(uv), .normal = normal, .depth = closestIntersectionDistance, .object = closestObject };
+}
+
+Color Ray::traceDirect(const Scene& scene, uint32_t rayDepth, double scatterPdf, const Vector& scatterNormal, bool emissionOnly, Features* features) const
+{
+	double closestIntersectionDistance;
+	const Object* closestObject = closestIntersection(scene, closestIntersectionDistance);
+
+	if (! closestObject)
+	{
+		const Color backgroundColor = background(scene);
+
+		if (features)
+			*features = Features{ .albedo = backgroundColor, .normal = Vector(), .depth = 0, .object = nullptr };
+
+		return backgroundColor * scene.lights.backgroundWeight(*this, scatterPdf);
+	}
+
+	// The surface is shaded as a path tracer's first bounce would be, but with no light
+	// bouncing back to it from anything other than the lights.
+	Material::Bounce bounce;
+	bounce.incident	= m_direction;
+	bounce.position	= at(closestIntersectionDistance);
+	bounce.rayDepth	= rayDepth + 1;
+
+	bounce.emissionWeight = scene.lights.emissionWeight(*closestObject, bounce.position, *this, scatterNormal, scatterPdf);
+
+	Material& material = closestObject->getSurfaceProperties(*this, bounce.position, bounce.normal, bounce.uv);
+
+	if (emissionOnly)
+		return material.emit(m_direction, bounce.position, bounce.normal, bounce.uv) * bounce.emissionWeight;
+
+	material.bounce(scene.lights, bounce);
+
+	if (features)
+		*features = Features{ .albedo = material.albedo(bounce.uv), .normal = bounce.normal, .depth = closestIntersectionDistance, .object = closestObject };
+
+	Color color = bounce.emitted;
+
+	if (bounce.lightRay)
+		color += bounce.lightWeight * scene.lights.traceEmission(scene, bounce.light, *bounce.lightRay);
+
+	// Surfaces that the lights were sampled from still scatter a ray, to find the lights that
+	// sampling them doesn't (and to weight those it does against); mirrors and glass reflect
+	// whatever their ray finds, up to a point.
+	if (bounce.scatterRay && (material.canSampleLights() || bounce.rayDepth < kMaxPreviewDepth))
+		color += bounce.weight * bounce.scatterRay->traceDirect(scene, bounce.rayDepth, bounce.scatterPdf, bounce.normal, material.canSampleLights(), nullptr);
+
+	return color;
 }
@@ -1,10 +1,14 @@
 #pragma once
 
 #include "Engine/Color.hpp"
+#include "Engine/Features.hpp"
+#include "Engine/PhotonMap.hpp"
 #include "Engine/Vector.hpp"
 
 #include <limits>
 
+class Object;
+
 struct Scene;
 
 class Ray
@@ -20,7 +24,33 @@ public:
 
 	const Vector		at(double distance) const	{ return m_position + (m_direction * distance); }
 
-	Color				trace(const Scene& scene, uint32_t rayDepth) const;
+	const Object*		closestIntersection(const Scene& scene, double& distance) const;
+	Color				background(const Scene& scene) const;
+
+	Color				trace(const Scene& scene, uint32_t rayDepth, double scatterPdf = 0, const Vector& scatterNormal = Vector()) const;
+
+	// Traces a camera ray, also recording the features of what it hits first.
+	Color				trace(const Scene& scene, Features& features) const;
+
+	// Cheap previews of a camera ray, which also record the features of what it hits first.
+	// Direct lighting only takes the light reaching each surface straight from the lights
+	// (following mirrors and glass a few bounces, so they don't show up black), and ambient
+	// occlusion shades the albedo by how much of the surface's hemisphere is left open by
+	// anything within the given distance.
+	Color				traceDirect(const Scene& scene, Features& features) const;
+	Color				traceOcclusion(const Scene& scene, double distance, Features& features) const;
+
+	// The features of what a camera ray hits first, without lighting it.
+	Features			firstHit(const Scene& scene) const;
+
+private:
+	// afterDiffuse is whether the ray continues a path that has already left a diffuse surface,
+	// so that the light leaving the next diffuse surface it hits can be taken from the cache.
+	Color				trace(const Scene& scene, uint32_t rayDepth, double scatterPdf, const Vector& scatterNormal, PhotonMap::CausticPath causticPath, bool afterDiffuse, Features* features) const;
+
+	// emissionOnly is whether the ray was scattered from a surface that the lights were sampled
+	// from, so that only the light it reaches is taken, and what it hits isn't lit in turn.
+	Color				traceDirect(const Scene& scene, uint32_t rayDepth, double scatterPdf, const Vector& scatterNormal, bool emissionOnly, Features* features) const;
 
 private:
 	Vector				m_position;
@@ -2,63 +2,252 @@
 
 #include "Engine/Camera.hpp"
 #include "Engine/Color.hpp"
+#include "Engine/Denoiser.hpp"
+#include "Engine/Material.hpp"
+#include "Engine/Object.hpp"
 #include "Engine/Random.hpp"
 #include "Engine/Vector.hpp"
 
 #include <algorithm>
+#include <cstdio>
 
 namespace
 {
 	constexpr size_t kMaxLinesToRenderPerChunk	= 1;
 	constexpr size_t kCoarsePreviewSpacing		= 4;
+	constexpr uint32_t kTimeBudgetSamplesPerPass	= 1;
+	constexpr uint32_t kCheckpointSamplesPerPass	= 4;
+	constexpr uint32_t kGuidingSamplesPerPass	= 4;
+	constexpr uint32_t kPhotonSamplesPerPass	= 4;
+	constexpr uint32_t kCacheSamplesPerPass		= 1;
+	constexpr double kAmbientOcclusionDistance	= 2;
+	constexpr uint64_t kRandomSeed				= 0x5EED5EED5EED5EEDull;
 }
 
-Renderer::Renderer(size_t width, size_t height, size_t numRenderThreads)
+std::optional<Renderer::Aov> Renderer::ParseAov(const std::string& name)
+{
+	if (name == "depth")
+		return Aov::Depth;
+	else if (name == "normal")
+		return Aov::Normal;
+	else if (name == "albedo")
+		return Aov::Albedo;
+	else if (name == "object")
+		return Aov::ObjectId;
+	else if (name == "material")
+		return Aov::MaterialId;
+	else
+		return std::nullopt;
+}
+
+std::string Renderer::AovName(Aov aov)
+{
+	switch (aov)
+	{
+		case Aov::Depth:
+			return "depth";
+		case Aov::Normal:
+			return "normal";
+		case Aov::Albedo:
+			return "albedo";
+		case Aov::ObjectId:
+			return "object";
+		case Aov::MaterialId:
+			return "material";
+	}
+
+	return {};
+}
+
+std::string Renderer::ShadingName(Shading shading)
+{
+	switch (shading)
+	{
+		case Shading::Full:
+			return "Full";
+		case Shading::DirectLighting:
+			return "Direct Lighting";
+		case Shading::AmbientOcclusion:
+			return "Ambient Occlusion";
+		case Shading::Albedo:
+			return "Albedo";
+		case Shading::Normals:
+			return "Normals";
+	}
+
+	return {};
+}
+
+Renderer::Renderer(size_t width, size_t height, size_t numRenderThreads, ThreadAffinity affinity)
 	: m_width(width)
 	, m_height(height)
 	, m_pixels(width * height)
+	, m_accumulatedSamples(width * height)
+	, m_sampleCounts(width * height)
+	, m_accumulatedFeatures(width * height)
+	, m_objectIds(width * height)
+	, m_materialIds(width * height)
+	, m_threadPlacement(affinity, numRenderThreads)
 	, m_renderThreads(numRenderThreads)
 {
 	clear();
 
-	for (auto& t : m_renderThreads)
+	for (size_t threadIndex = 0; threadIndex < m_renderThreads.size(); threadIndex++)
 	{
-		t = std::thread(
-			[this]()
+		m_renderThreads[threadIndex] = std::thread(
+			[this, threadIndex]()
 			{
+				m_threadPlacement.pinCurrentThread(threadIndex);
+
+				// Allocate the per-thread buffers from the thread itself, once it has been
+				// pinned; the kernel's first-touch policy then places them in memory local
+				// to the NUMA node the thread is running on.
+				ThreadState threadState
+					{
+						.lineSamples		= std::vector<Color>(m_width),
+						.lineFeatures		= std::vector<Features>(m_width),
+						.lineObjectIds		= std::vector<uint32_t>(m_width),
+						.lineMaterialIds	= std::vector<uint32_t>(m_width),
+						.wavefront			= WavefrontIntegrator(),
+					};
+
 				for (;;)
 				{
 					std::unique_lock lock(m_lock);
 
-					m_renderStateCondition.wait(lock, [&] { return m_renderState != RenderState::Stop; });
+					// A checkpoint taken at the end of a pass, to be written once the lock is released.
+					std::optional<Checkpoint> checkpoint;
+					std::string checkpointPath;
+
+					m_renderStateCondition.wait(lock,
+						[&]
+						{
+							if (m_renderState == RenderState::Exit)
+								return true;
+
+							if (m_threadFunction && m_threadFunctionCalls < m_renderThreads.size())
+								return true;
+
+							if (m_renderState != RenderState::Run)
+								return false;
+
+							// Each pass starts by shooting its photons, before any of its lines.
+							if (m_shootingPhotons)
+								return m_scene.photons->hasChunksToShoot();
+
+							return m_lastRenderLineStart < m_renderRegion.y + m_renderRegion.height && ! deadlineExpired();
+						});
 
 					if (m_renderState == RenderState::Exit)
 						return;
 
+					// Work handed to the threads between renders, such as denoising, takes the
+					// place of rendering until every call of it has been started.
+					if (m_threadFunction && m_threadFunctionCalls < m_renderThreads.size())
+					{
+						const auto* function = m_threadFunction;
+						m_threadFunctionCalls++;
+
+						lock.unlock();
+						(*function)();
+						lock.lock();
+
+						if (++m_finishedThreadFunctionCalls == m_renderThreads.size())
+						{
+							lock.unlock();
+							m_renderStateCondition.notify_all();
+						}
+
+						continue;
+					}
+
 					m_busyThreads++;
 
-					const size_t startLine = m_lastRenderLineStart.fetch_add(kMaxLinesToRenderPerChunk);
-					const size_t endLine = startLine + std::min(kMaxLinesToRenderPerChunk, m_height - startLine);
-					if (m_renderState == RenderState::Run && (startLine < m_height) && (endLine <= m_height))
+					const size_t regionEndLine = m_renderRegion.y + m_renderRegion.height;
+
+					if (m_shootingPhotons)
 					{
 						lock.unlock();
-						renderLines(startLine, endLine);
+						while (m_renderState == RenderState::Run && ! deadlineExpired() && m_scene.photons->shootChunk(m_scene))
+							;
 						lock.lock();
 
-						m_finishedLines += (endLine - startLine);
+						if (m_scene.photons->ready())
+							m_shootingPhotons = false;
+					}
+					else
+					{
+						const size_t startLine = m_lastRenderLineStart.fetch_add(kMaxLinesToRenderPerChunk);
+						const size_t endLine = startLine + std::min(kMaxLinesToRenderPerChunk, regionEndLine - startLine);
+						if (m_renderState == RenderState::Run && (startLine < regionEndLine) && (endLine <= regionEndLine))
+						{
+							lock.unlock();
+							const bool finished = renderLines(threadState, startLine, endLine);
+							lock.lock();
+
+							if (finished)
+								m_finishedLines += (endLine - startLine);
+						}
 					}
 
 					if (--m_busyThreads == 0)
 					{
-						if (m_renderState == RenderState::Run && m_lastRenderLineStart >= m_height)
+						if (m_renderState == RenderState::Run && ((! m_shootingPhotons && m_lastRenderLineStart >= regionEndLine) || deadlineExpired()))
 						{
-							m_renderState = RenderState::Stop;
-							m_renderEndTime = std::chrono::steady_clock::now();
+							// Once every line of the current pass is complete we can start the next
+							// pass over the frame, unless we've run out of passes or time.
+							if (m_currentPass + 1 < m_totalPasses && ! deadlineExpired())
+							{
+								// The path guide learns from each pass, to guide the next.
+								if (m_scene.guide)
+									m_scene.guide->update();
+
+								// As does the radiance cache, which every pass can draw on.
+								if (m_scene.cache)
+									m_scene.cache->update();
+
+								// No other thread is tracing between passes, so the buffers can be copied as they are.
+								// Only one checkpoint is written at a time, so they can't overtake each other.
+								if (m_checkpointSettings && ! m_region && m_pendingCheckpoints == 0 && (std::chrono::steady_clock::now() - m_lastCheckpointTime) >= m_checkpointSettings->interval)
+								{
+									checkpoint = takeCheckpoint();
+									checkpointPath = m_checkpointSettings->path;
+
+									m_pendingCheckpoints++;
+									m_lastCheckpointTime = std::chrono::steady_clock::now();
+								}
+
+								m_currentPass++;
+								m_lastRenderLineStart = m_renderRegion.y;
+
+								// Every pass gathers caustics from photons of its own.
+								if (m_scene.photons && m_shading == Shading::Full)
+									m_shootingPhotons = ! m_scene.photons->beginPass(m_scene, m_currentPass);
+							}
+							else
+							{
+								m_renderState = RenderState::Stop;
+								m_renderEndTime = std::chrono::steady_clock::now();
+							}
 						}
 
 						lock.unlock();
 						m_renderStateCondition.notify_all();
 					}
+
+					// The checkpoint is written without holding the lock, so that the next pass
+					// (and stopping the render) doesn't have to wait for the disk.
+					if (checkpoint)
+					{
+						if (! checkpoint->save(checkpointPath))
+							fprintf(stderr, "Failed to save checkpoint to '%s'\n", checkpointPath.c_str());
+
+						lock.lock();
+						m_pendingCheckpoints--;
+						lock.unlock();
+
+						m_renderStateCondition.notify_all();
+					}
 				}
 			}
 		);
@@ -85,6 +274,27 @@ void Renderer::setScene(Scene scene)
 	stopRender();
 
 	m_scene = std::move(scene);
+
+	// Objects are numbered in the order the scene lists them, and materials in the order
+	// the objects use them, leaving 0 for pixels that hit nothing.
+	std::unordered_map<const Material*, uint32_t> materialIds;
+
+	m_sceneIds.clear();
+
+	for (size_t i = 0; i < m_scene.objects.size(); i++)
+	{
+		const Object& object = *m_scene.objects[i];
+		const uint32_t materialId = materialIds.try_emplace(&object.material(), static_cast<uint32_t>(materialIds.size() + 1)).first->second;
+
+		m_sceneIds[&object] = Ids{ .object = static_cast<uint32_t>(i + 1), .material = materialId };
+	}
+}
+
+void Renderer::setCamera(const Camera& camera)
+{
+	stopRender();
+
+	m_scene.camera = camera;
 }
 
 void Renderer::setCoarsePreview(bool preview)
@@ -97,16 +307,184 @@ void Renderer::setCoarsePreview(bool preview)
 	m_coarsePreview = preview;
 }
 
+void Renderer::setShading(Shading shading)
+{
+	stopRender();
+
+	m_shading = shading;
+}
+
+void Renderer::setKeepRadianceCache(bool keep)
+{
+	stopRender();
+
+	m_keepRadianceCache = keep;
+}
+
+void Renderer::setTimeBudget(std::optional<std::chrono::milliseconds> timeBudget)
+{
+	stopRender();
+
+	m_timeBudget = timeBudget;
+}
+
+void Renderer::setRegion(std::optional<Region> region, std::optional<uint32_t> samplesPerPixel)
+{
+	stopRender();
+
+	if (region)
+	{
+		// Clip the requested region to the frame, discarding it entirely if nothing remains.
+		region->x		= std::min(region->x, m_width);
+		region->y		= std::min(region->y, m_height);
+		region->width	= std::min(region->width, m_width - region->x);
+		region->height	= std::min(region->height, m_height - region->y);
+
+		if (! region->width || ! region->height)
+			region.reset();
+	}
+
+	m_region = region;
+	m_regionSamplesPerPixel = region ? samplesPerPixel : std::nullopt;
+}
+
+std::vector<Color> Renderer::samples(const Region& region) const
+{
+	// The averaged linear color of each pixel in the region, before it's quantized
+	// into the 8-bit pixel buffer.
+	std::vector<Color> regionSamples;
+	regionSamples.reserve(region.width * region.height);
+
+	for (size_t y = region.y; y < region.y + region.height; y++)
+	{
+		for (size_t x = region.x; x < region.x + region.width; x++)
+		{
+			const size_t currentPixel = (y * m_width) + x;
+			regionSamples.push_back(m_sampleCounts[currentPixel] ? (m_accumulatedSamples[currentPixel] / m_sampleCounts[currentPixel]) : Color());
+		}
+	}
+
+	return regionSamples;
+}
+
+std::vector<Color> Renderer::aov(Aov aov) const
+{
+	// Each value fills all three channels, except for normals and albedo.
+	std::vector<Color> values(m_pixels.size());
+
+	for (size_t i = 0; i < values.size(); i++)
+	{
+		if (! m_sampleCounts[i])
+			continue;
+
+		const Features features = m_accumulatedFeatures[i] / m_sampleCounts[i];
+
+		switch (aov)
+		{
+			case Aov::Depth:
+				values[i] = Color(features.depth, features.depth, features.depth);
+				break;
+
+			case Aov::Normal:
+			{
+				const double normalLength = features.normal.length();
+				const Vector normal = normalLength > 0 ? features.normal / normalLength : Vector();
+
+				values[i] = Color(normal.x(), normal.y(), normal.z());
+				break;
+			}
+
+			case Aov::Albedo:
+				values[i] = features.albedo;
+				break;
+
+			case Aov::ObjectId:
+				values[i] = Color(m_objectIds[i], m_objectIds[i], m_objectIds[i]);
+				break;
+
+			case Aov::MaterialId:
+				values[i] = Color(m_materialIds[i], m_materialIds[i], m_materialIds[i]);
+				break;
+		}
+	}
+
+	return values;
+}
+
+void Renderer::setCheckpointing(std::optional<CheckpointSettings> settings)
+{
+	stopRender();
+
+	m_checkpointSettings = std::move(settings);
+}
+
 void Renderer::clear()
 {
 	const uint32_t fillColor = Palette::kBlack.toRGBA8888();
 	std::fill(m_pixels.begin(), m_pixels.end(), fillColor);
+
+	std::fill(m_accumulatedSamples.begin(), m_accumulatedSamples.end(), Color());
+	std::fill(m_sampleCounts.begin(), m_sampleCounts.end(), 0);
+	std::fill(m_accumulatedFeatures.begin(), m_accumulatedFeatures.end(), Features());
+	std::fill(m_objectIds.begin(), m_objectIds.end(), 0);
+	std::fill(m_materialIds.begin(), m_materialIds.end(), 0);
+}
+
+void Renderer::updatePixels(bool denoise)
+{
+	if (isRendering())
+		return;
+
+	std::vector<Color> colors(m_pixels.size());
+	std::vector<Features> features(m_pixels.size());
+
+	for (size_t i = 0; i < m_pixels.size(); i++)
+	{
+		if (m_sampleCounts[i])
+		{
+			colors[i] = m_accumulatedSamples[i] / m_sampleCounts[i];
+			features[i] = m_accumulatedFeatures[i] / m_sampleCounts[i];
+		}
+	}
+
+	if (denoise)
+		colors = Denoiser(m_width, m_height, [this](const std::function<void()>& function) { runOnRenderThreads(function); }).denoise(colors, features);
+
+	// Pixels that haven't been rendered keep whatever they were showing before.
+	for (size_t i = 0; i < m_pixels.size(); i++)
+	{
+		if (m_sampleCounts[i])
+			m_pixels[i] = colors[i].toRGBA8888();
+	}
+}
+
+void Renderer::runOnRenderThreads(const std::function<void()>& function)
+{
+	if (m_renderThreads.empty())
+	{
+		function();
+		return;
+	}
+
+	std::unique_lock lock(m_lock);
+
+	m_threadFunction				= &function;
+	m_threadFunctionCalls			= 0;
+	m_finishedThreadFunctionCalls	= 0;
+
+	lock.unlock();
+	m_renderStateCondition.notify_all();
+	lock.lock();
+
+	m_renderStateCondition.wait(lock, [&] { return m_finishedThreadFunctionCalls == m_renderThreads.size(); });
+
+	m_threadFunction = nullptr;
 }
 
 void Renderer::waitForRenderCompletion()
 {
 	std::unique_lock lock(m_lock);
-	m_renderStateCondition.wait(lock, [&] { return m_busyThreads == 0; });
+	m_renderStateCondition.wait(lock, [&] { return m_renderState != RenderState::Run && m_busyThreads == 0 && m_pendingCheckpoints == 0; });
 }
 
 void Renderer::stopRender()
@@ -128,36 +506,169 @@ void Renderer::stopRender()
 }
 
 void Renderer::startRender()
+{
+	beginRender(nullptr);
+}
+
+bool Renderer::resumeRender(const Checkpoint& checkpoint)
+{
+	return beginRender(&checkpoint);
+}
+
+bool Renderer::beginRender(const Checkpoint* checkpoint)
 {
 	std::unique_lock lock(m_lock);
 
 	if (m_renderState == RenderState::Run)
-		return;
+		return false;
 
 	lock.unlock();
 	stopRender();
 	lock.lock();
 
-	m_lastRenderLineStart = 0;
-	m_finishedLines = 0;
+	// Only the selected region of the frame (if any) is rendered, with its own sample count.
+	m_renderRegion = m_region.value_or(Region{ .x = 0, .y = 0, .width = m_width, .height = m_height });
+
+	m_samplesPerPixel = std::max<uint32_t>(m_regionSamplesPerPixel.value_or(m_scene.samplesPerPixel), 1);
+
+	// With a time budget we render the region in progressive single sample passes, so
+	// that every pixel has a similar sample count whenever the deadline is reached.
+	// The requested sample count is then only an upper limit on the number of passes.
+	// Checkpoints are only taken between passes, so they need several passes too, as do
+	// path guiding and the radiance cache, which only learn between passes, and caustic
+	// photons, which shrink the radius they're gathered over with every pass.
+	if (m_timeBudget)
+		m_samplesPerPass = kTimeBudgetSamplesPerPass;
+	else if (m_scene.guide)
+		m_samplesPerPass = std::min(kGuidingSamplesPerPass, m_samplesPerPixel);
+	else if (m_scene.photons)
+		m_samplesPerPass = std::min(kPhotonSamplesPerPass, m_samplesPerPixel);
+	else if (m_scene.cache)
+		m_samplesPerPass = std::min(kCacheSamplesPerPass, m_samplesPerPixel);
+	else if (m_checkpointSettings && ! m_region)
+		m_samplesPerPass = std::min(kCheckpointSamplesPerPass, m_samplesPerPixel);
+	else
+		m_samplesPerPass = m_samplesPerPixel;
+
+	m_totalPasses = (m_samplesPerPixel + m_samplesPerPass - 1) / m_samplesPerPass;
+
+	if (checkpoint)
+	{
+		// A checkpoint can only continue the exact render it was taken from.
+		const bool compatible =
+			! m_region &&
+			checkpoint->seed == kRandomSeed &&
+			checkpoint->width == m_width &&
+			checkpoint->height == m_height &&
+			checkpoint->samplesPerPixel == m_samplesPerPixel &&
+			checkpoint->samplesPerPass == m_samplesPerPass &&
+			checkpoint->completedPasses <= m_totalPasses &&
+			checkpoint->accumulatedSamples.size() == m_accumulatedSamples.size() &&
+			checkpoint->sampleCounts.size() == m_sampleCounts.size() &&
+			checkpoint->accumulatedFeatures.size() == m_accumulatedFeatures.size() &&
+			checkpoint->objectIds.size() == m_objectIds.size() &&
+			checkpoint->materialIds.size() == m_materialIds.size() &&
+			checkpoint->guideRecords.size() == (m_scene.guide ? PathGuide::kNumRecords : 0) &&
+			checkpoint->cacheRecords.size() == (m_scene.cache ? RadianceCache::kNumRecords : 0) &&
+			(! m_checkpointSettings || checkpoint->sceneHash == m_checkpointSettings->sceneHash);
+
+		if (! compatible)
+			return false;
+
+		m_accumulatedSamples = checkpoint->accumulatedSamples;
+		m_sampleCounts = checkpoint->sampleCounts;
+		m_accumulatedFeatures = checkpoint->accumulatedFeatures;
+		m_objectIds = checkpoint->objectIds;
+		m_materialIds = checkpoint->materialIds;
+
+		if (m_scene.guide)
+		{
+			m_scene.guide->reset(m_scene);
+			m_scene.guide->restore(checkpoint->guideRecords);
+		}
+
+		if (m_scene.cache)
+			m_scene.cache->restore(checkpoint->cacheRecords);
+
+		for (size_t i = 0; i < m_pixels.size(); i++)
+			m_pixels[i] = m_sampleCounts[i] ? (m_accumulatedSamples[i] / m_sampleCounts[i]).toRGBA8888() : Palette::kBlack.toRGBA8888();
+
+		m_currentPass = checkpoint->completedPasses;
+	}
+	else
+	{
+		// Samples from any previous render are discarded, but the existing pixels are left
+		// intact so that they remain visible until they are overwritten by the new render.
+		for (size_t y = m_renderRegion.y; y < m_renderRegion.y + m_renderRegion.height; y++)
+		{
+			const size_t lineStart = (y * m_width) + m_renderRegion.x;
+
+			std::fill_n(m_accumulatedSamples.begin() + lineStart, m_renderRegion.width, Color());
+			std::fill_n(m_sampleCounts.begin() + lineStart, m_renderRegion.width, 0);
+			std::fill_n(m_accumulatedFeatures.begin() + lineStart, m_renderRegion.width, Features());
+			std::fill_n(m_objectIds.begin() + lineStart, m_renderRegion.width, 0);
+			std::fill_n(m_materialIds.begin() + lineStart, m_renderRegion.width, 0);
+		}
+
+		// Each render learns its own guide from scratch, so that it doesn't depend on what
+		// was rendered before it.
+		if (m_scene.guide)
+			m_scene.guide->reset(m_scene);
+
+		// As does the radiance cache, unless asked to carry on from whatever earlier renders of
+		// the scene recorded, as the light leaving its surfaces doesn't depend on the camera.
+		if (m_scene.cache)
+		{
+			if (m_keepRadianceCache)
+				m_scene.cache->update();
+			else
+				m_scene.cache->reset();
+		}
+
+		m_currentPass = 0;
+	}
+
+	m_lastRenderLineStart = m_renderRegion.y;
+	m_finishedLines = m_currentPass * m_renderRegion.height;
 
 	m_renderStartTime = std::chrono::steady_clock::now();
-	m_renderEndTime = {};
+	m_renderEndTime = m_renderStartTime;
+	m_renderDeadline = m_timeBudget ? (m_renderStartTime + *m_timeBudget) : std::chrono::steady_clock::time_point::max();
+	m_lastCheckpointTime = m_renderStartTime;
+
+	// Resuming from a checkpoint of a completed render leaves nothing more to do.
+	if (m_currentPass >= m_totalPasses)
+		return true;
+
+	// The photons of each pass depend only on the pass, so a resumed render simply shoots
+	// those of the pass it continues from. Previews don't gather caustics, so need none.
+	m_shootingPhotons = m_scene.photons && m_shading == Shading::Full && ! m_scene.photons->beginPass(m_scene, m_currentPass);
 
 	m_renderState = RenderState::Run;
 
 	lock.unlock();
 	m_renderStateCondition.notify_all();
+
+	return true;
 }
 
 bool Renderer::isRendering() const
 {
-	return m_renderState.load() == RenderState::Run || m_busyThreads.load() != 0;
+	// A render isn't finished until its last checkpoint is on disk, so that the checkpoint can
+	// be removed once the image is saved.
+	return m_renderState.load() == RenderState::Run || m_busyThreads.load() != 0 || m_pendingCheckpoints.load() != 0;
 }
 
 uint8_t Renderer::renderPercentage() const
 {
-	return static_cast<uint8_t>(100.0 * m_finishedLines.load() / m_height);
+	double percentage = 100.0 * m_finishedLines.load() / (std::max<size_t>(m_renderRegion.height, 1) * std::max<uint32_t>(m_totalPasses, 1));
+
+	// If we're working to a deadline, report whichever of the elapsed time or completed
+	// passes will finish the render first.
+	if (m_timeBudget && m_timeBudget->count())
+		percentage = std::max(percentage, 100.0 * renderTime().count() / m_timeBudget->count());
+
+	return static_cast<uint8_t>(std::min(percentage, 100.0));
 }
 
 std::chrono::milliseconds Renderer::renderTime() const
@@ -166,49 +677,222 @@ std::chrono::milliseconds Renderer::renderTime() const
 	return std::chrono::duration_cast<std::chrono::milliseconds>(renderTime);
 }
 
-void Renderer::renderLines(size_t startLine, size_t endLine)
+uint32_t Renderer::renderedSamplesPerPixel() const
+{
+	// Only count passes over the frame that were fully completed, as a partially
+	// completed pass will have only added extra samples to some of the pixels.
+	const size_t completedPasses = m_finishedLines.load() / std::max<size_t>(m_renderRegion.height, 1);
+
+	return static_cast<uint32_t>(std::min<size_t>(completedPasses * m_samplesPerPass, m_samplesPerPixel));
+}
+
+bool Renderer::deadlineExpired() const
+{
+	return std::chrono::steady_clock::now() >= m_renderDeadline;
+}
+
+uint32_t Renderer::samplesInPass(uint32_t pass) const
 {
-	uint32_t* currentPixel = &m_pixels[startLine * m_width];
+	// The final pass only renders whatever samples remain.
+	return std::min(m_samplesPerPass, m_samplesPerPixel - (pass * m_samplesPerPass));
+}
+
+Checkpoint Renderer::takeCheckpoint() const
+{
+	return Checkpoint
+		{
+			.sceneHash				= m_checkpointSettings->sceneHash,
+			.seed					= kRandomSeed,
+			.width					= static_cast<uint32_t>(m_width),
+			.height					= static_cast<uint32_t>(m_height),
+			.samplesPerPixel		= m_samplesPerPixel,
+			.samplesPerPass			= m_samplesPerPass,
+			.completedPasses		= m_currentPass + 1,
+			.accumulatedSamples		= m_accumulatedSamples,
+			.sampleCounts			= m_sampleCounts,
+			.accumulatedFeatures	= m_accumulatedFeatures,
+			.objectIds				= m_objectIds,
+			.materialIds			= m_materialIds,
+			.guideRecords			= m_scene.guide ? m_scene.guide->records() : std::vector<uint64_t>(),
+			.cacheRecords			= m_scene.cache ? m_scene.cache->records() : std::vector<uint64_t>(),
+		};
+}
+
+Renderer::Ids Renderer::idsOf(const Object* object) const
+{
+	const auto ids = object ? m_sceneIds.find(object) : m_sceneIds.end();
+
+	return ids != m_sceneIds.end() ? ids->second : Ids();
+}
+
+void Renderer::recordIds(ThreadState& threadState, size_t x, const Object* object) const
+{
+	const Ids ids = idsOf(object);
+
+	threadState.lineObjectIds[x]	= ids.object;
+	threadState.lineMaterialIds[x]	= ids.material;
+}
 
+Ray Renderer::cameraRay(size_t x, size_t y, uint32_t sample) const
+{
 	const double xSampleOffset = 1.0 / m_width;
 	const double ySampleOffset = 1.0 / m_height;
 
-	for (size_t y = startLine; y < endLine; y++)
+	const double u = x * xSampleOffset;
+	const double v = y * ySampleOffset;
+
+	// Every sample of every pixel is traced with its own random sequence, so the image
+	// is identical however the work is split between threads and passes, including when
+	// a render is resumed from a checkpoint.
+	Random::Start(m_scene.sampler.get(), static_cast<uint32_t>(x), static_cast<uint32_t>(y), sample, kRandomSeed);
+
+	// Apply some jitter within the current pixel, so we average out aliasing errors.
+	const auto [jitterU, jitterV] = Random::Sample2D(Random::CameraDimension::Pixel);
+
+	double sampleU = std::clamp(u + .5 * xSampleOffset * ((2 * jitterU) - 1), 0.0, 1.0);
+	double sampleV = std::clamp(v + .5 * ySampleOffset * ((2 * jitterV) - 1), 0.0, 1.0);
+
+	return m_scene.camera.generateRay(sampleU, sampleV);
+}
+
+Color Renderer::shade(const Ray& ray, Features& features) const
+{
+	switch (m_shading)
 	{
-		if (m_renderState.load() != RenderState::Run)
+		case Shading::Full:
 			break;
 
+		case Shading::DirectLighting:
+			return ray.traceDirect(m_scene, features);
+
+		case Shading::AmbientOcclusion:
+			return ray.traceOcclusion(m_scene, kAmbientOcclusionDistance, features);
+
+		case Shading::Albedo:
+			features = ray.firstHit(m_scene);
+			return features.albedo;
+
+		case Shading::Normals:
+			features = ray.firstHit(m_scene);
+			return Color((features.normal.x() + 1) / 2, (features.normal.y() + 1) / 2, (features.normal.z() + 1) / 2);
+	}
+
+	return ray.trace(m_scene, features);
+}
+
+bool Renderer::renderLines(ThreadState& threadState, size_t startLine, size_t endLine)
+{
+	const uint32_t firstSample = m_currentPass * m_samplesPerPass;
+	const uint32_t numSamples = samplesInPass(m_currentPass);
+
+	for (size_t y = startLine; y < endLine; y++)
+	{
 		if (m_coarsePreview && (y % kCoarsePreviewSpacing != 0))
 		{
 			// If we're doing a coarse preview render, we only render every few lines to save time.
-			currentPixel += m_width;
 			continue;
 		}
 
-		for (size_t x = 0; x < m_width; x++)
+		// Continue each pixel's running sum rather than summing each pass separately, so
+		// that floating point rounding doesn't depend on how the samples were split up.
+		for (size_t x = m_renderRegion.x; x < m_renderRegion.x + m_renderRegion.width; x++)
 		{
 			if (m_coarsePreview && (x % kCoarsePreviewSpacing != 0))
 			{
 				// If we're doing a coarse preview render, we only render every few pixels in a line to save time.
-				currentPixel++;
 				continue;
 			}
 
-			const double u = x * xSampleOffset;
-			const double v = y * ySampleOffset;
+			threadState.lineSamples[x] = m_accumulatedSamples[(y * m_width) + x];
+			threadState.lineFeatures[x] = m_accumulatedFeatures[(y * m_width) + x];
+			threadState.lineObjectIds[x] = m_objectIds[(y * m_width) + x];
+			threadState.lineMaterialIds[x] = m_materialIds[(y * m_width) + x];
+		}
+
+		// Previews are cheap enough to be traced a pixel at a time, whichever integrator the
+		// scene uses.
+		if (m_scene.integrator == Scene::Integrator::Wavefront && m_shading == Shading::Full)
+		{
+			// Trace one sample of every pixel in the line as a single batch of paths. Stopping
+			// the render is checked between batches, and the partially traced line discarded.
+			auto& wavefront = threadState.wavefront;
+
+			for (uint32_t sample = firstSample; sample < firstSample + numSamples; sample++)
+			{
+				if (m_renderState.load() != RenderState::Run)
+					return false;
+
+				wavefront.clear();
+
+				for (size_t x = m_renderRegion.x; x < m_renderRegion.x + m_renderRegion.width; x++)
+				{
+					if (m_coarsePreview && (x % kCoarsePreviewSpacing != 0))
+						continue;
+
+					wavefront.addPath(cameraRay(x, y, sample));
+				}
+
+				wavefront.trace(m_scene);
+
+				size_t path = 0;
+				for (size_t x = m_renderRegion.x; x < m_renderRegion.x + m_renderRegion.width; x++)
+				{
+					if (m_coarsePreview && (x % kCoarsePreviewSpacing != 0))
+						continue;
+
+					threadState.lineSamples[x] += wavefront.radiance(path).clamped();
+					threadState.lineFeatures[x] += wavefront.features(path);
 
-			Color accumulatedSamples;
+					if (sample == 0)
+						recordIds(threadState, x, wavefront.features(path).object);
 
-			for (size_t sample = 0; sample < m_scene.samplesPerPixel; sample++)
+					path++;
+				}
+			}
+		}
+		else
+		{
+			for (size_t x = m_renderRegion.x; x < m_renderRegion.x + m_renderRegion.width; x++)
 			{
-				// Apply some jitter within the current pixel, so we average out aliasing errors.
-				double sampleU = std::clamp(u + .5 * xSampleOffset * Random::SignedNormal(), 0.0, 1.0);
-				double sampleV = std::clamp(v + .5 * ySampleOffset * Random::SignedNormal(), 0.0, 1.0);
+				if (m_coarsePreview && (x % kCoarsePreviewSpacing != 0))
+					continue;
 
-				accumulatedSamples += m_scene.camera.trace(m_scene, sampleU, sampleV).clamped();
+				for (uint32_t sample = firstSample; sample < firstSample + numSamples; sample++)
+				{
+					// Check for the render being stopped before every sample, rather than once per line,
+					// so that stopping never has to wait for more than a single path to be traced. The
+					// partially traced line is then discarded, leaving the frame buffers untouched.
+					if (m_renderState.load() != RenderState::Run)
+						return false;
+
+					Features features;
+					threadState.lineSamples[x] += shade(cameraRay(x, y, sample), features).clamped();
+					threadState.lineFeatures[x] += features;
+
+					if (sample == 0)
+						recordIds(threadState, x, features.object);
+				}
 			}
+		}
 
-			*(currentPixel++) = (accumulatedSamples / m_scene.samplesPerPixel).toRGBA8888();
+		// Merge the line's new samples into the shared frame buffers in one go, once the
+		// entire line has been traced.
+		for (size_t x = m_renderRegion.x; x < m_renderRegion.x + m_renderRegion.width; x++)
+		{
+			if (m_coarsePreview && (x % kCoarsePreviewSpacing != 0))
+				continue;
+
+			const size_t currentPixel = (y * m_width) + x;
+
+			m_accumulatedSamples[currentPixel] = threadState.lineSamples[x];
+			m_accumulatedFeatures[currentPixel] = threadState.lineFeatures[x];
+			m_objectIds[currentPixel] = threadState.lineObjectIds[x];
+			m_materialIds[currentPixel] = threadState.lineMaterialIds[x];
+			m_sampleCounts[currentPixel] += numSamples;
+
+			m_pixels[currentPixel] = (m_accumulatedSamples[currentPixel] / m_sampleCounts[currentPixel]).toRGBA8888();
 		}
 	}
+
+	return true;
 }
@@ -1,12 +1,20 @@
 #pragma once
 
+#include "Checkpoint.hpp"
+#include "Features.hpp"
 #include "Scene.hpp"
+#include "ThreadPlacement.hpp"
+#include "WavefrontIntegrator.hpp"
 
 #include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 #include <condition_variable>
 #include <mutex>
@@ -17,48 +25,167 @@ private:
 	enum class RenderState { Stop, Run, Exit };
 
 public:
-											Renderer(size_t width, size_t height, size_t numRenderThreads);
+	struct Region
+	{
+		size_t								x = 0;
+		size_t								y = 0;
+		size_t								width = 0;
+		size_t								height = 0;
+	};
+
+	// Arbitrary output variables: buffers written alongside the image, filled from what each
+	// pixel's camera rays hit first as it's rendered.
+	enum class Aov
+	{
+		Depth,		// Distance along the camera ray, averaged over the pixel; 0 for the background
+		Normal,		// Averaged over the pixel, then normalized
+		Albedo,		// Averaged over the pixel; the background's color where nothing was hit
+		ObjectId,	// From the pixel's first sample; 1 for the scene's first object, 0 for none
+		MaterialId,	// From the pixel's first sample, numbering the materials in the order objects use them
+	};
+
+	// How each sample is shaded. Anything but Full is a cheap preview, that shows what the scene
+	// looks like long before a path traced render of it would.
+	enum class Shading
+	{
+		Full,				// Paths traced by the scene's integrator
+		DirectLighting,		// Only the light reaching surfaces straight from the lights
+		AmbientOcclusion,	// The albedo, darkened where nearby objects close in around surfaces
+		Albedo,				// The albedo alone, unlit
+		Normals,			// The normal, mapped from [-1, 1] to [0, 1] in each channel
+	};
+
+	struct CheckpointSettings
+	{
+		std::string							path;
+		std::chrono::seconds				interval = std::chrono::seconds(0);
+		uint64_t							sceneHash = 0;
+	};
+
+	static std::optional<Aov>				ParseAov(const std::string& name);
+	static std::string						AovName(Aov aov);
+	static std::string						ShadingName(Shading shading);
+
+											Renderer(size_t width, size_t height, size_t numRenderThreads, ThreadAffinity affinity = ThreadAffinity::None);
 											~Renderer();
 
 	void									setScene(Scene scene);
+	void									setCamera(const Camera& camera);
 	void									setCoarsePreview(bool preview);
+	void									setShading(Shading shading);
+	void									setKeepRadianceCache(bool keep);
+	void									setTimeBudget(std::optional<std::chrono::milliseconds> timeBudget);
+	void									setRegion(std::optional<Region> region, std::optional<uint32_t> samplesPerPixel = std::nullopt);
+	void									setCheckpointing(std::optional<CheckpointSettings> settings);
+
+	size_t									width() const { return m_width; }
+	size_t									height() const { return m_height; }
 
 	const uint32_t* 						pixels() const { return m_pixels.data(); }
+	std::vector<Color>						samples(const Region& region) const;
+	std::vector<Color>						aov(Aov aov) const;
+
+	const ThreadPlacement&					threadPlacement() const { return m_threadPlacement; }
 
 	void									clear();
 
+	// Rebuilds the pixels of a finished render from its samples, denoising them if asked to.
+	void									updatePixels(bool denoise);
+
 	void									waitForRenderCompletion();
 	void									stopRender();
 	void									startRender();
+	bool									resumeRender(const Checkpoint& checkpoint);
 
 	bool									isRendering() const;
 	uint8_t									renderPercentage() const;
 	std::chrono::milliseconds				renderTime() const;
+	uint32_t								renderedSamplesPerPixel() const;
 
 private:
-	void									renderLines(size_t startLine, size_t endLine);
+	struct ThreadState
+	{
+		std::vector<Color>					lineSamples;
+		std::vector<Features>				lineFeatures;
+		std::vector<uint32_t>				lineObjectIds;
+		std::vector<uint32_t>				lineMaterialIds;
+		WavefrontIntegrator					wavefront;
+	};
+
+	struct Ids
+	{
+		uint32_t							object = 0;
+		uint32_t							material = 0;
+	};
+
+	// Calls the function as many times as there are render threads, each call from one of them,
+	// and returns once all of the calls have finished; for work that the calls share out
+	// between themselves, so that it runs on the threads as placed. Mustn't be called while
+	// rendering.
+	void									runOnRenderThreads(const std::function<void()>& function);
+
+	bool									beginRender(const Checkpoint* checkpoint);
+	bool									deadlineExpired() const;
+	uint32_t								samplesInPass(uint32_t pass) const;
+
+	Checkpoint								takeCheckpoint() const;
+
+	Ids										idsOf(const Object* object) const;
+	void									recordIds(ThreadState& threadState, size_t x, const Object* object) const;
+
+	Ray										cameraRay(size_t x, size_t y, uint32_t sample) const;
+	Color									shade(const Ray& ray, Features& features) const;
+	bool									renderLines(ThreadState& threadState, size_t startLine, size_t endLine);
 
 private:
 	size_t									m_width = 0;
 	size_t									m_height = 0;
 
 	std::vector<uint32_t>					m_pixels;
+	std::vector<Color>						m_accumulatedSamples;
+	std::vector<uint32_t>					m_sampleCounts;
+	std::vector<Features>					m_accumulatedFeatures;
+	std::vector<uint32_t>					m_objectIds;
+	std::vector<uint32_t>					m_materialIds;
 
 	bool									m_coarsePreview = false;
+	Shading									m_shading = Shading::Full;
+	bool									m_keepRadianceCache = false;
+	std::optional<std::chrono::milliseconds>	m_timeBudget;
+	std::optional<Region>					m_region;
+	std::optional<uint32_t>					m_regionSamplesPerPixel;
+	std::optional<CheckpointSettings>		m_checkpointSettings;
 
 	Scene									m_scene;
+	std::unordered_map<const Object*, Ids>	m_sceneIds;
 
 	std::mutex								m_lock;
 
 	std::condition_variable					m_renderStateCondition;
 	std::atomic<RenderState>				m_renderState = RenderState::Stop;
 
+	ThreadPlacement							m_threadPlacement;
 	std::vector<std::thread>				m_renderThreads;
 
 	std::chrono::steady_clock::time_point	m_renderStartTime = {};
 	std::chrono::steady_clock::time_point	m_renderEndTime = {};
+	std::chrono::steady_clock::time_point	m_renderDeadline = std::chrono::steady_clock::time_point::max();
+	std::chrono::steady_clock::time_point	m_lastCheckpointTime = {};
+
+	Region									m_renderRegion;
+	uint32_t								m_samplesPerPixel = 0;
+	uint32_t								m_samplesPerPass = 0;
+	uint32_t								m_totalPasses = 0;
+	std::atomic<uint32_t>					m_currentPass = 0;
+	bool									m_shootingPhotons = false;
 
 	std::atomic<size_t>						m_busyThreads = 0;
+
+	// The function runOnRenderThreads() is running, and how many calls of it have started and finished.
+	const std::function<void()>*			m_threadFunction = nullptr;
+	size_t									m_threadFunctionCalls = 0;
+	size_t									m_finishedThreadFunctionCalls = 0;
+	std::atomic<size_t>						m_pendingCheckpoints = 0;
 	std::atomic<size_t>						m_lastRenderLineStart = 0;
 	std::atomic<size_t>						m_finishedLines = 0;
 };
@@ -0,0 +1,104 @@
+#include "Engine/Sampler.hpp"
+
+#include <array>
+#include <cstddef>
+
+namespace
+{
+	constexpr uint32_t kBitCount	= 32;
+	constexpr uint32_t kByteCount	= 4;
+
+	// The generator matrices of the first two Sobol dimensions, as tables of the bits each byte
+	// of an index contributes, so a point is four lookups rather than a loop over its bits.
+	// Later dimensions are padded out from these two, scrambling and shuffling each pair
+	// differently.
+	constexpr auto kSobolTables = []
+		{
+			std::array<std::array<uint32_t, kBitCount>, 2> directions = {};
+
+			uint32_t direction = 1u << 31;
+			for (uint32_t bit = 0; bit < kBitCount; bit++)
+			{
+				directions[0][bit] = 1u << (31 - bit);
+				directions[1][bit] = direction;
+
+				direction ^= direction >> 1;
+			}
+
+			std::array<std::array<std::array<uint32_t, 256>, kByteCount>, 2> tables = {};
+
+			for (size_t dimension = 0; dimension < 2; dimension++)
+			{
+				for (uint32_t byte = 0; byte < kByteCount; byte++)
+				{
+					for (uint32_t value = 0; value < 256; value++)
+					{
+						for (uint32_t bit = 0; bit < 8; bit++)
+						{
+							if (value & (1u << bit))
+								tables[dimension][byte][value] ^= directions[dimension][(byte * 8) + bit];
+						}
+					}
+				}
+			}
+
+			return tables;
+		}();
+
+	uint32_t ReverseBits(uint32_t value)
+	{
+		value = ((value >> 1) & 0x55555555u) | ((value & 0x55555555u) << 1);
+		value = ((value >> 2) & 0x33333333u) | ((value & 0x33333333u) << 2);
+		value = ((value >> 4) & 0x0F0F0F0Fu) | ((value & 0x0F0F0F0Fu) << 4);
+		value = ((value >> 8) & 0x00FF00FFu) | ((value & 0x00FF00FFu) << 8);
+
+		return (value >> 16) | (value << 16);
+	}
+
+	// Owen scrambling, implemented as a hash that only mixes each bit into the bits below it
+	// (Burley, "Practical Hash-based Owen Scrambling").
+	uint32_t NestedUniformScramble(uint32_t value, uint32_t seed)
+	{
+		value = ReverseBits(value);
+
+		value += seed;
+		value ^= value * 0x6C50B47Cu;
+		value ^= value * 0xB82F1E52u;
+		value ^= value * 0xC7AFE638u;
+		value ^= value * 0x8D22F6E6u;
+
+		return ReverseBits(value);
+	}
+
+	uint32_t SobolBits(uint32_t index, uint32_t dimension)
+	{
+		const auto& table = kSobolTables[dimension];
+
+		return table[0][index & 0xFF] ^ table[1][(index >> 8) & 0xFF] ^ table[2][(index >> 16) & 0xFF] ^ table[3][index >> 24];
+	}
+}
+
+uint32_t Sampler::Hash(uint32_t value)
+{
+	value ^= value >> 16;
+	value *= 0x7FEB352Du;
+	value ^= value >> 15;
+	value *= 0x846CA68Bu;
+	value ^= value >> 16;
+
+	return value;
+}
+
+uint32_t Sampler::HashCombine(uint32_t seed, uint32_t value)
+{
+	return Hash(seed ^ (Hash(value) + 0x9E3779B9u + (seed << 6) + (seed >> 2)));
+}
+
+double Sampler::Sobol(uint32_t index, uint32_t dimension, uint32_t seed)
+{
+	const uint32_t pairSeed	= HashCombine(seed, dimension / 2);
+	const uint32_t shuffled	= NestedUniformScramble(index, pairSeed);
+	const uint32_t bits		= NestedUniformScramble(SobolBits(shuffled, dimension % 2), HashCombine(pairSeed, dimension % 2));
+
+	return bits * 0x1p-32;
+}
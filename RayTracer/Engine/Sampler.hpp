@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+// Produces the numbers each sample of a pixel makes its random choices with, as a point in a
+// sample space with one dimension per choice. Unlike independent random numbers, a sampler can
+// spread the points of a pixel's samples evenly over that space, so fewer samples are needed
+// for the same quality.
+//
+// Dimensions come in pairs, for choices made with two numbers (such as picking a direction),
+// and the points are spread evenly over each pair.
+class Sampler
+{
+public:
+	virtual					~Sampler() = default;
+
+	// A number in [0, 1) for a dimension of one sample of a pixel.
+	virtual double			sample(uint32_t x, uint32_t y, uint32_t index, uint32_t dimension) const = 0;
+
+protected:
+	static uint32_t			Hash(uint32_t value);
+	static uint32_t			HashCombine(uint32_t seed, uint32_t value);
+
+	// The point of an Owen scrambled Sobol sequence, for the given dimension. Each pair of
+	// dimensions is scrambled (and its points shuffled) differently, based on the seed.
+	static double			Sobol(uint32_t index, uint32_t dimension, uint32_t seed);
+};
@@ -0,0 +1,154 @@
+#include "BlueNoiseSampler.hpp"
+
+#include <cmath>
+#include <cstddef>
+
+namespace
+{
+	constexpr size_t	kMaskSize		= 64;
+	constexpr size_t	kMaskArea		= kMaskSize * kMaskSize;
+	constexpr int		kKernelRadius	= 6;
+	constexpr double	kKernelSigma	= 1.5;
+	constexpr uint32_t	kPatternSeed	= 0xB1DE5EEDu;
+	constexpr uint32_t	kSequenceSeed	= 0x5EED5EEDu;
+}
+
+BlueNoiseSampler::BlueNoiseSampler()
+	: m_mask(MakeMask())
+{
+
+}
+
+double BlueNoiseSampler::sample(uint32_t x, uint32_t y, uint32_t index, uint32_t dimension) const
+{
+	// Offset the mask differently for each dimension, so the shifts aren't correlated.
+	const uint32_t offset	= Hash(dimension);
+	const size_t maskX		= (x + (offset & 0xFFFF)) % kMaskSize;
+	const size_t maskY		= (y + (offset >> 16)) % kMaskSize;
+
+	const double value = Sobol(index, dimension, kSequenceSeed) + m_mask[(maskY * kMaskSize) + maskX];
+
+	return value < 1 ? value : value - 1;
+}
+
+// Builds the mask with the void-and-cluster method (Ulichney, "The void-and-cluster method
+// for dither array generation"): pixels are ranked by repeatedly picking the one that's
+// furthest from those already picked, measured by a Gaussian energy field.
+std::vector<double> BlueNoiseSampler::MakeMask()
+{
+	std::vector<double> kernel;
+	for (int dy = -kKernelRadius; dy <= kKernelRadius; dy++)
+	{
+		for (int dx = -kKernelRadius; dx <= kKernelRadius; dx++)
+			kernel.push_back(std::exp(-((dx * dx) + (dy * dy)) / (2 * kKernelSigma * kKernelSigma)));
+	}
+
+	std::vector<char>	pattern(kMaskArea, false);
+	std::vector<double>	energy(kMaskArea, 0);
+
+	const auto splat = [&](std::vector<double>& field, size_t pixel, double sign)
+		{
+			const int x = static_cast<int>(pixel % kMaskSize);
+			const int y = static_cast<int>(pixel / kMaskSize);
+
+			const double* weight = kernel.data();
+			for (int dy = -kKernelRadius; dy <= kKernelRadius; dy++)
+			{
+				const size_t row = ((y + dy + kMaskSize) % kMaskSize) * kMaskSize;
+
+				for (int dx = -kKernelRadius; dx <= kKernelRadius; dx++)
+					field[row + ((x + dx + kMaskSize) % kMaskSize)] += sign * *weight++;
+			}
+		};
+
+	// The most (or least) energetic pixel that's set (or not) in the pattern.
+	const auto extreme = [&](const std::vector<double>& field, bool set, bool highest)
+		{
+			size_t best = kMaskArea;
+			for (size_t pixel = 0; pixel < kMaskArea; pixel++)
+			{
+				if (static_cast<bool>(pattern[pixel]) == set && (best == kMaskArea || (highest ? field[pixel] > field[best] : field[pixel] < field[best])))
+					best = pixel;
+			}
+
+			return best;
+		};
+
+	const auto setPixel = [&](std::vector<double>& field, size_t pixel, bool set)
+		{
+			pattern[pixel] = set;
+			splat(field, pixel, set ? 1 : -1);
+		};
+
+	// Start from a sparse random pattern, then move its most tightly clustered pixels into
+	// its largest voids until that would put them straight back.
+	size_t initialCount = 0;
+	for (uint32_t attempt = 0; initialCount < kMaskArea / 10; attempt++)
+	{
+		const size_t pixel = Hash(kPatternSeed + attempt) % kMaskArea;
+		if (! pattern[pixel])
+		{
+			setPixel(energy, pixel, true);
+			initialCount++;
+		}
+	}
+
+	for (;;)
+	{
+		const size_t cluster = extreme(energy, true, true);
+		setPixel(energy, cluster, false);
+
+		const size_t largestVoid = extreme(energy, false, false);
+		setPixel(energy, largestVoid, true);
+
+		if (largestVoid == cluster)
+			break;
+	}
+
+	std::vector<size_t> ranks(kMaskArea);
+
+	// Rank the initial pixels by removing the most tightly clustered first, from a copy.
+	{
+		const auto initialPattern	= pattern;
+		auto clusterEnergy			= energy;
+
+		for (size_t rank = initialCount; rank-- > 0;)
+		{
+			const size_t cluster = extreme(clusterEnergy, true, true);
+			setPixel(clusterEnergy, cluster, false);
+			ranks[cluster] = rank;
+		}
+
+		pattern = initialPattern;
+	}
+
+	// Fill the largest voids, up to half of the mask.
+	for (size_t rank = initialCount; rank < kMaskArea / 2; rank++)
+	{
+		const size_t largestVoid = extreme(energy, false, false);
+		setPixel(energy, largestVoid, true);
+		ranks[largestVoid] = rank;
+	}
+
+	// Beyond half, the unset pixels are the minority, so fill their tightest clusters instead.
+	std::vector<double> voidEnergy(kMaskArea, 0);
+	for (size_t pixel = 0; pixel < kMaskArea; pixel++)
+	{
+		if (! pattern[pixel])
+			splat(voidEnergy, pixel, 1);
+	}
+
+	for (size_t rank = kMaskArea / 2; rank < kMaskArea; rank++)
+	{
+		const size_t cluster = extreme(voidEnergy, false, true);
+		pattern[cluster] = true;
+		splat(voidEnergy, cluster, -1);
+		ranks[cluster] = rank;
+	}
+
+	std::vector<double> mask(kMaskArea);
+	for (size_t pixel = 0; pixel < kMaskArea; pixel++)
+		mask[pixel] = (ranks[pixel] + .5) / kMaskArea;
+
+	return mask;
+}
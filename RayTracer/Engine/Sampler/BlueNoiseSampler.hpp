@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Engine/Sampler.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// Owen scrambled Sobol points shared by every pixel, with each pixel's points shifted by
+// the value of a blue noise mask (offset differently for each dimension). Neighboring pixels
+// then have very different points, so at low sample counts the remaining error looks like
+// fine, even grain rather than blotches.
+class BlueNoiseSampler final
+	: public Sampler
+{
+public:
+								BlueNoiseSampler();
+								~BlueNoiseSampler() override = default;
+
+// Sampler i/f:
+public:
+	double						sample(uint32_t x, uint32_t y, uint32_t index, uint32_t dimension) const override;
+
+private:
+	static std::vector<double>	MakeMask();
+
+private:
+	// A square, tileable mask of values evenly spread over [0, 1).
+	std::vector<double>			m_mask;
+};
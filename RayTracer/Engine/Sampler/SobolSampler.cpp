@@ -0,0 +1,6 @@
+#include "SobolSampler.hpp"
+
+double SobolSampler::sample(uint32_t x, uint32_t y, uint32_t index, uint32_t dimension) const
+{
+	return Sobol(index, dimension, HashCombine(Hash(x), y));
+}
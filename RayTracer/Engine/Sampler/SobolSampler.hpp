@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Engine/Sampler.hpp"
+
+#include <cstdint>
+
+// Owen scrambled Sobol points, scrambled differently for every pixel so that their errors
+// aren't correlated with one another.
+class SobolSampler final
+	: public Sampler
+{
+public:
+							SobolSampler() = default;
+							~SobolSampler() override = default;
+
+// Sampler i/f:
+public:
+	double					sample(uint32_t x, uint32_t y, uint32_t index, uint32_t dimension) const override;
+};
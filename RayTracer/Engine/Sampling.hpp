@@ -0,0 +1,180 @@
+#pragma once
+
+#include "Engine/Vector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+// Closed-form warps from uniform samples in [0, 1) onto the domains the renderer samples, each
+// paired with the exact density of the directions (or points) it produces. Directions over a
+// hemisphere are given in the local space of a Frame, with the surface normal along z.
+namespace Sampling
+{
+	// An orthonormal basis around a unit normal, built without branching on its direction
+	// (Duff et al., "Building an Orthonormal Basis, Revisited").
+	struct Frame
+	{
+		explicit Frame(const Vector& unitNormal)
+			: normal(unitNormal)
+		{
+			const double sign	= std::copysign(1.0, normal.z());
+			const double a		= -1 / (sign + normal.z());
+			const double b		= normal.x() * normal.y() * a;
+
+			tangent		= Vector(1 + (sign * normal.x() * normal.x() * a), sign * b, -sign * normal.x());
+			bitangent	= Vector(b, sign + (normal.y() * normal.y() * a), -normal.y());
+		}
+
+		Vector toWorld(const Vector& local) const
+		{
+			return (tangent * local.x()) + (bitangent * local.y()) + (normal * local.z());
+		}
+
+		Vector toLocal(const Vector& world) const
+		{
+			return Vector(world.dotProduct(tangent), world.dotProduct(bitangent), world.dotProduct(normal));
+		}
+
+		Vector	tangent;
+		Vector	bitangent;
+		Vector	normal;
+	};
+
+	// Maps the unit square onto the unit disk (in x and y), keeping neighboring samples close
+	// together (Shirley and Chiu, "A Low Distortion Map Between Disk and Square").
+	inline Vector ConcentricDisk(double u, double v)
+	{
+		const double a = (2 * u) - 1;
+		const double b = (2 * v) - 1;
+
+		if (a == 0 && b == 0)
+			return StandardVectors::kZero;
+
+		const auto [radius, angle] = std::abs(a) > std::abs(b)
+			? std::pair(a, (std::numbers::pi / 4) * (b / a))
+			: std::pair(b, (std::numbers::pi / 2) - ((std::numbers::pi / 4) * (a / b)));
+
+		return Vector(radius * std::cos(angle), radius * std::sin(angle), 0);
+	}
+
+	inline Vector UniformSphere(double u, double v)
+	{
+		const double z			= 1 - (2 * u);
+		const double radius		= std::sqrt(std::max(0.0, 1 - (z * z)));
+		const double rotation	= 2 * std::numbers::pi * v;
+
+		return Vector(radius * std::cos(rotation), radius * std::sin(rotation), z);
+	}
+
+	constexpr double UniformSpherePdf()
+	{
+		return 1 / (4 * std::numbers::pi);
+	}
+
+	// Directions within a cone around z, where coneSize is one minus the cosine of its half-angle.
+	inline Vector UniformCone(double u, double v, double coneSize)
+	{
+		const double cosAngle	= 1 - (u * coneSize);
+		const double sinAngle	= std::sqrt(std::max(0.0, 1 - (cosAngle * cosAngle)));
+		const double rotation	= 2 * std::numbers::pi * v;
+
+		return Vector(sinAngle * std::cos(rotation), sinAngle * std::sin(rotation), cosAngle);
+	}
+
+	constexpr double UniformConePdf(double coneSize)
+	{
+		return 1 / (2 * std::numbers::pi * coneSize);
+	}
+
+	// Projecting points on the unit disk up onto the hemisphere gives a cosine weighted
+	// distribution of directions (Malley's method).
+	inline Vector CosineHemisphere(double u, double v)
+	{
+		const Vector disk = ConcentricDisk(u, v);
+
+		return Vector(disk.x(), disk.y(), std::sqrt(std::max(0.0, 1 - disk.lengthSquared())));
+	}
+
+	constexpr double CosineHemispherePdf(double cosAngle)
+	{
+		return cosAngle > 0 ? cosAngle / std::numbers::pi : 0;
+	}
+
+	// Barycentric coordinates of a point uniformly distributed over a triangle's area.
+	inline Vector UniformTriangle(double u, double v)
+	{
+		const double r = std::sqrt(u);
+
+		return Vector(1 - r, r * (1 - v), r * v);
+	}
+
+	// The GGX (Trowbridge-Reitz) distribution of microfacet normals, for a surface with the given
+	// roughness (alpha), and the Smith shadowing-masking terms that go with it.
+	inline double GgxDistribution(const Vector& halfway, double alpha)
+	{
+		if (halfway.z() <= 0)
+			return 0;
+
+		const double alphaSquared	= alpha * alpha;
+		const double cosSquared		= halfway.z() * halfway.z();
+		const double denominator	= (cosSquared * (alphaSquared - 1)) + 1;
+
+		return alphaSquared / (std::numbers::pi * denominator * denominator);
+	}
+
+	inline double GgxLambda(const Vector& direction, double alpha)
+	{
+		const double cosSquared = direction.z() * direction.z();
+		if (cosSquared <= 0)
+			return 0;
+
+		const double tanSquared = std::max(0.0, 1 - cosSquared) / cosSquared;
+
+		return (std::sqrt(1 + (alpha * alpha * tanSquared)) - 1) / 2;
+	}
+
+	inline double GgxMasking(const Vector& direction, double alpha)
+	{
+		return 1 / (1 + GgxLambda(direction, alpha));
+	}
+
+	inline double GgxShadowingMasking(const Vector& outgoing, const Vector& incoming, double alpha)
+	{
+		return 1 / (1 + GgxLambda(outgoing, alpha) + GgxLambda(incoming, alpha));
+	}
+
+	// Picks a microfacet normal from those visible from the outgoing direction (Heitz, "Sampling
+	// the GGX Distribution of Visible Normals"), so that reflecting about it never wastes a
+	// sample on a facet facing away from the viewer.
+	inline Vector GgxVisibleNormal(const Vector& outgoing, double alpha, double u, double v)
+	{
+		// Stretch the view into the configuration where the distribution is a hemisphere.
+		const Vector	view			= Vector(alpha * outgoing.x(), alpha * outgoing.y(), outgoing.z()).unit();
+		const double	lengthSquared	= (view.x() * view.x()) + (view.y() * view.y());
+		const Vector	tangent			= lengthSquared > 0 ? Vector(-view.y(), view.x(), 0) / std::sqrt(lengthSquared) : StandardVectors::kUnitX;
+		const Vector	bitangent		= view.crossProduct(tangent);
+
+		// Sample the part of the disk that projects onto the visible side of the hemisphere.
+		const double radius		= std::sqrt(u);
+		const double rotation	= 2 * std::numbers::pi * v;
+		const double t1			= radius * std::cos(rotation);
+		const double blend		= (1 + view.z()) / 2;
+		const double t2			= ((1 - blend) * std::sqrt(std::max(0.0, 1 - (t1 * t1)))) + (blend * radius * std::sin(rotation));
+
+		const Vector normal = (tangent * t1) + (bitangent * t2) + (view * std::sqrt(std::max(0.0, 1 - (t1 * t1) - (t2 * t2))));
+
+		// Unstretch it back.
+		return Vector(alpha * normal.x(), alpha * normal.y(), std::max(0.0, normal.z())).unit();
+	}
+
+	// The density of GgxVisibleNormal() picking a normal, reflected to give the incoming direction.
+	inline double GgxReflectionPdf(const Vector& outgoing, const Vector& halfway, double alpha)
+	{
+		if (outgoing.z() <= 0)
+			return 0;
+
+		return GgxMasking(outgoing, alpha) * GgxDistribution(halfway, alpha) / (4 * outgoing.z());
+	}
+}
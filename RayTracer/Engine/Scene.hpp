@@ -1,7 +1,12 @@
 #pragma once
 
 #include "Engine/Camera.hpp"
+#include "Engine/LightList.hpp"
 #include "Engine/Object.hpp"
+#include "Engine/PathGuide.hpp"
+#include "Engine/PhotonMap.hpp"
+#include "Engine/RadianceCache.hpp"
+#include "Engine/Sampler.hpp"
 #include "Engine/Texture.hpp"
 
 #include <cstdint>
@@ -11,9 +16,36 @@
 struct Scene
 {
 public:
+	enum class Integrator
+	{
+		Recursive,	// Follows each path to completion before starting the next
+		Wavefront,	// Advances a batch of paths together, one bounce at a time
+	};
+
 	std::shared_ptr<Texture>				background;
 	Camera									camera;
 	std::vector<std::shared_ptr<Object>>	objects;
+	LightList								lights;
+
+	// One camera per frame when the scene describes an animated sequence, empty
+	// for a single still image using the main camera.
+	std::vector<Camera>						sequence;
 
 	uint32_t								samplesPerPixel = 25;
+	Integrator								integrator = Integrator::Recursive;
+
+	// Where each sample's random choices come from; independent random numbers if null.
+	std::shared_ptr<const Sampler>			sampler;
+
+	// Learns where light comes from as the scene is rendered, to steer scattered rays towards
+	// it; null unless path guiding is enabled.
+	std::shared_ptr<PathGuide>				guide;
+
+	// The caustics cast by specular objects, gathered from photons shot at them each pass;
+	// null unless caustic photons are enabled.
+	std::shared_ptr<PhotonMap>				photons;
+
+	// The light leaving diffuse surfaces, which paths take instead of following it once they've
+	// left a diffuse surface; null unless the radiance cache is enabled.
+	std::shared_ptr<RadianceCache>			cache;
 };
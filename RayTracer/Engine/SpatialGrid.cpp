@@ -0,0 +1,26 @@
+#include "Engine/SpatialGrid.hpp"
+
+#include "Engine/BoundingBox.hpp"
+#include "Engine/Object.hpp"
+
+namespace SpatialGrid
+{
+	double CellSize(const std::vector<std::shared_ptr<Object>>& objects, double cellsAcrossScene)
+	{
+		BoundingBox bounds;
+
+		for (const auto& object : objects)
+		{
+			const BoundingBox& objectBounds = object->boundingBox();
+
+			if (std::isfinite(objectBounds.size().lengthSquared()))
+			{
+				bounds.include(objectBounds.lower());
+				bounds.include(objectBounds.upper());
+			}
+		}
+
+		const double sceneSize = VectorUtils::MaxComponent(bounds.size());
+		return (std::isfinite(sceneSize) && sceneSize > 0 && cellsAcrossScene > 0) ? sceneSize / cellsAcrossScene : 1;
+	}
+}
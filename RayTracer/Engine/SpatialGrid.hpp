@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Engine/Vector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Object;
+
+// A uniform grid of cubic cells over all of space, as used by RadianceCache, PathGuide and
+// PhotonMap. Cells are identified by a hash of their coordinates, so that whatever is kept
+// for them can live in a fixed size table however large or sparse the scene is.
+namespace SpatialGrid
+{
+	// The size of the cells of which the given number span the largest dimension of the bounds
+	// of the objects. Only objects of a finite size count towards the bounds, so that ground
+	// planes and backdrops don't stretch the cells to cover them. The cells are of size 1 if
+	// there's nothing finite to span.
+	double CellSize(const std::vector<std::shared_ptr<Object>>& objects, double cellsAcrossScene);
+
+	// The coordinate of the cell a value falls in along one axis, clamped so that positions
+	// far from the scene still land in a cell.
+	inline int64_t Coordinate(double value, double cellSize)
+	{
+		constexpr double kMaxCoordinate = 1e15;
+
+		return static_cast<int64_t>(std::clamp(std::floor(value / cellSize), -kMaxCoordinate, kMaxCoordinate));
+	}
+
+	// Hashes a cell's coordinates, along with a small value that further splits the cell, with
+	// the finalizer of SplitMix64 mixing the bits so that any of them can index a table.
+	inline uint64_t Hash(int64_t x, int64_t y, int64_t z, uint64_t split = 0)
+	{
+		uint64_t hash = (static_cast<uint64_t>(x) * 73856093ull) ^ (static_cast<uint64_t>(y) * 19349663ull) ^ (static_cast<uint64_t>(z) * 83492791ull) ^ (split * 2654435761ull);
+
+		hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+		hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+
+		return hash ^ (hash >> 31);
+	}
+
+	inline uint64_t Hash(const Vector& position, double cellSize, uint64_t split = 0)
+	{
+		return Hash(Coordinate(position.x(), cellSize), Coordinate(position.y(), cellSize), Coordinate(position.z(), cellSize), split);
+	}
+}
@@ -14,6 +14,9 @@ public:
 						Texture(size_t width, size_t height, const Color& multiplier, Interpolation interpolation);
 	virtual				~Texture() = default;
 
+	size_t				width() const	{ return m_width; }
+	size_t				height() const	{ return m_height; }
+
 	Color				sample(double u, double v) const;
 
 protected:
@@ -0,0 +1,204 @@
+#include "Engine/ThreadPlacement.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <iterator>
+#include <map>
+#include <tuple>
+
+#if defined(__linux__)
+	#include <sched.h>
+
+	#include <filesystem>
+	#include <fstream>
+#endif
+
+namespace
+{
+#if defined(__linux__)
+	uint32_t ReadTopologyValue(const std::string& path, uint32_t defaultValue)
+	{
+		std::ifstream file(path);
+
+		uint32_t value;
+		if (! (file >> value))
+			return defaultValue;
+
+		return value;
+	}
+#endif
+}
+
+std::optional<ThreadAffinity> ThreadPlacement::ParseAffinity(const std::string& name)
+{
+	if (name == "none")
+		return ThreadAffinity::None;
+	else if (name == "compact")
+		return ThreadAffinity::Compact;
+	else if (name == "scatter")
+		return ThreadAffinity::Scatter;
+	else
+		return std::nullopt;
+}
+
+ThreadPlacement::ThreadPlacement(ThreadAffinity affinity, size_t numThreads)
+	: m_affinity(affinity)
+{
+	if (m_affinity == ThreadAffinity::None)
+		return;
+
+	const auto cpus = detectCpus();
+	if (cpus.empty())
+	{
+		m_affinity = ThreadAffinity::None;
+		return;
+	}
+
+	// Group the CPUs by NUMA node, as that's what decides which memory is local
+	// to them, and order each node's CPUs so that we use all of the physical
+	// cores (highest capacity first, so that performance cores on hybrid systems
+	// are used before efficiency cores) before we start doubling up on their SMT
+	// siblings. A node usually matches a package, but large packages may be split
+	// into several nodes.
+	std::map<uint32_t, std::vector<Cpu>> nodes;
+	for (const auto& cpu : cpus)
+		nodes[cpu.node].push_back(cpu);
+
+	for (auto& [node, nodeCpus] : nodes)
+	{
+		std::sort(nodeCpus.begin(), nodeCpus.end(),
+			[](const Cpu& a, const Cpu& b)
+			{
+				return std::make_tuple(a.sibling, -static_cast<int64_t>(a.capacity), a.package, a.core, a.id) < std::make_tuple(b.sibling, -static_cast<int64_t>(b.capacity), b.package, b.core, b.id);
+			});
+	}
+
+	switch (m_affinity)
+	{
+		case ThreadAffinity::Compact:
+		{
+			// Fill up each node completely before moving onto the next, to keep
+			// threads (and their memory) as close together as possible.
+			for (const auto& [node, nodeCpus] : nodes)
+				m_cpus.insert(m_cpus.end(), nodeCpus.begin(), nodeCpus.end());
+
+			break;
+		}
+
+		case ThreadAffinity::Scatter:
+		{
+			// Round-robin the threads across the nodes, to make use of as much of
+			// the total memory bandwidth and cache of the system as possible.
+			for (size_t index = 0; m_cpus.size() < cpus.size(); index++)
+			{
+				for (const auto& [node, nodeCpus] : nodes)
+				{
+					if (index < nodeCpus.size())
+						m_cpus.push_back(nodeCpus[index]);
+				}
+			}
+
+			break;
+		}
+
+		case ThreadAffinity::None:
+			break;
+	}
+
+	// We only need as many CPUs as there are threads to place; any extra threads
+	// will wrap around and share CPUs.
+	if (m_cpus.size() > numThreads)
+		m_cpus.resize(numThreads);
+}
+
+std::optional<ThreadPlacement::Cpu> ThreadPlacement::cpuForThread(size_t threadIndex) const
+{
+	if (m_cpus.empty())
+		return std::nullopt;
+
+	return m_cpus[threadIndex % m_cpus.size()];
+}
+
+bool ThreadPlacement::pinCurrentThread(size_t threadIndex) const
+{
+	const auto cpu = cpuForThread(threadIndex);
+	if (! cpu)
+		return false;
+
+#if defined(__linux__)
+	cpu_set_t cpuSet;
+	CPU_ZERO(&cpuSet);
+	CPU_SET(cpu->id, &cpuSet);
+
+	return sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0;
+#else
+	return false;
+#endif
+}
+
+std::string ThreadPlacement::report() const
+{
+	if (m_cpus.empty())
+		return "Render threads are not pinned to CPUs.\n";
+
+	std::string report;
+
+	for (size_t i = 0; i < m_cpus.size(); i++)
+	{
+		const auto& cpu = m_cpus[i];
+
+		char buffer[128];
+		snprintf(buffer, std::size(buffer), "Render thread %zu -> CPU %u (package %u, core %u, SMT %u, node %u, capacity %u)\n", i, cpu.id, cpu.package, cpu.core, cpu.sibling, cpu.node, cpu.capacity);
+		buffer[std::size(buffer) - 1] = '\0';
+
+		report += buffer;
+	}
+
+	return report;
+}
+
+std::vector<ThreadPlacement::Cpu> ThreadPlacement::detectCpus()
+{
+	std::vector<Cpu> cpus;
+
+#if defined(__linux__)
+	// Only consider the CPUs we're actually allowed to run on.
+	cpu_set_t allowedCpus;
+	CPU_ZERO(&allowedCpus);
+	if (sched_getaffinity(0, sizeof(allowedCpus), &allowedCpus) != 0)
+		return {};
+
+	for (uint32_t id = 0; id < CPU_SETSIZE; id++)
+	{
+		if (! CPU_ISSET(id, &allowedCpus))
+			continue;
+
+		const std::string cpuPath = "/sys/devices/system/cpu/cpu" + std::to_string(id);
+
+		Cpu cpu;
+		cpu.id			= id;
+		cpu.package		= ReadTopologyValue(cpuPath + "/topology/physical_package_id", 0);
+		cpu.core		= ReadTopologyValue(cpuPath + "/topology/core_id", id);
+		cpu.capacity	= ReadTopologyValue(cpuPath + "/cpu_capacity", ReadTopologyValue(cpuPath + "/cpufreq/cpuinfo_max_freq", 0));
+
+		// The NUMA node a CPU belongs to is exposed as a "nodeN" link in its directory.
+		std::error_code error;
+		for (const auto& entry : std::filesystem::directory_iterator(cpuPath, error))
+		{
+			const auto name = entry.path().filename().string();
+			if (name.starts_with("node") && name.size() > 4 && std::all_of(name.begin() + 4, name.end(), [](unsigned char c) { return std::isdigit(c) != 0; }))
+				cpu.node = static_cast<uint32_t>(std::stoul(name.substr(4)));
+		}
+
+		cpus.push_back(cpu);
+	}
+
+	// Number each CPU within its physical core, so we can tell SMT siblings apart.
+	std::map<std::pair<uint32_t, uint32_t>, uint32_t> coreThreads;
+	for (auto& cpu : cpus)
+		cpu.sibling = coreThreads[{ cpu.package, cpu.core }]++;
+#endif
+
+	return cpus;
+}
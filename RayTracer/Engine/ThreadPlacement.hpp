@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+enum class ThreadAffinity
+{
+	None,
+	Compact,
+	Scatter
+};
+
+class ThreadPlacement
+{
+public:
+	struct Cpu
+	{
+		uint32_t				id = 0;
+		uint32_t				package = 0;
+		uint32_t				core = 0;
+		uint32_t				node = 0;
+		uint32_t				sibling = 0;
+		uint32_t				capacity = 0;
+	};
+
+	static std::optional<ThreadAffinity>	ParseAffinity(const std::string& name);
+
+								ThreadPlacement(ThreadAffinity affinity, size_t numThreads);
+
+	ThreadAffinity				affinity() const	{ return m_affinity; }
+
+	std::optional<Cpu>			cpuForThread(size_t threadIndex) const;
+	bool						pinCurrentThread(size_t threadIndex) const;
+
+	std::string					report() const;
+
+private:
+	static std::vector<Cpu>		detectCpus();
+
+private:
+	ThreadAffinity				m_affinity = ThreadAffinity::None;
+	std::vector<Cpu>			m_cpus;
+};
@@ -1,7 +1,5 @@
 #pragma once
 
-#include "Engine/Random.hpp"
-
 #include <algorithm>
 #include <cmath>
 #include <limits>
@@ -210,16 +208,6 @@ namespace VectorUtils
 	{
 		return std::max(std::max(v.x(), v.y()), v.z());
 	}
-
-	static inline Vector RandomUnitVector()
-	{
-	    for (;;)
-	    {
-			auto v = Vector(Random::SignedNormal(), Random::SignedNormal(), Random::SignedNormal());
-			if (v.lengthSquared() > 1e-10 && v.lengthSquared() <= 1)
-				return v.unit();
-		}
-	}
 }
 
 namespace StandardVectors
@@ -0,0 +1,250 @@
+#include "Engine/WavefrontIntegrator.hpp"
+
+#include "Engine/Object.hpp"
+#include "Engine/Random.hpp"
+#include "Engine/Scene.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <span>
+
+void WavefrontIntegrator::clear()
+{
+	m_paths.clear();
+	m_activePaths.clear();
+	m_hits.clear();
+	m_bounces.clear();
+	m_guidedVertices.clear();
+	m_cachedVertices.clear();
+}
+
+size_t WavefrontIntegrator::addPath(const Ray& ray)
+{
+	// Each path carries on with the random sequence it was started with, so it makes
+	// exactly the same choices as it would when traced by the recursive integrator.
+	m_paths.push_back(
+		{
+			.ray		= ray,
+			.throughput	= Palette::kWhite,
+			.radiance	= Color(),
+			.features	= Features(),
+			.sequence	= Random::CurrentSequence(),
+		});
+
+	return m_paths.size() - 1;
+}
+
+void WavefrontIntegrator::trace(const Scene& scene)
+{
+	m_activePaths.clear();
+
+	for (size_t path = 0; path < m_paths.size(); path++)
+		m_activePaths.push_back(path);
+
+	while (! m_activePaths.empty())
+	{
+		findClosestHits(scene);
+		shadeHits(scene);
+		traceLightRays(scene);
+		queueContinuations();
+	}
+
+	for (const auto& vertex : m_guidedVertices)
+		scene.guide->record(vertex.position, vertex.normal, vertex.direction, vertex.radiance.luminance() / vertex.pdf);
+
+	for (const auto& vertex : m_cachedVertices)
+		scene.cache->record(vertex.position, vertex.normal, vertex.radiance);
+}
+
+void WavefrontIntegrator::findClosestHits(const Scene& scene)
+{
+	m_hits.clear();
+
+	for (const size_t pathIndex : m_activePaths)
+	{
+		auto& path = m_paths[pathIndex];
+
+		double distance;
+		const Object* object = path.ray.closestIntersection(scene, distance);
+
+		if (! object)
+		{
+			// We hit nothing, so the path ends with the scene background.
+			const Color backgroundColor = path.ray.background(scene);
+
+			if (path.rayDepth == 0)
+				path.features = Features{ .albedo = backgroundColor, .normal = Vector(), .depth = 0, .object = nullptr };
+
+			if (scene.photons && scene.photons->carries(path.ray, Ray::kNoIntersection, path.causticPath))
+				continue;
+
+			const double backgroundWeight = scene.lights.backgroundWeight(path.ray, path.scatterPdf);
+
+			path.radiance += path.throughput * backgroundColor * backgroundWeight;
+			gatherRadiance(path, backgroundColor * backgroundWeight);
+			continue;
+		}
+
+		// Past the first diffuse surface, the light leaving any other is taken from the cache
+		// where it's known, ending the path there.
+		if (scene.cache && path.afterDiffuse && object->material().isDiffuse())
+		{
+			const Vector position = path.ray.at(distance);
+
+			Vector normal;
+			Vector uv;
+			object->getSurfaceProperties(path.ray, position, normal, uv);
+
+			if (const Color* radiance = scene.cache->lookup(position, normal))
+			{
+				path.radiance += path.throughput * *radiance;
+				gatherRadiance(path, *radiance);
+				continue;
+			}
+		}
+
+		m_hits.push_back({ .path = pathIndex, .object = object, .material = &object->material(), .distance = distance });
+	}
+}
+
+void WavefrontIntegrator::shadeHits(const Scene& scene)
+{
+	// Group the hits by material, so that each material (and so each texture) shades all
+	// of its hits together. The order paths are shaded in doesn't affect their results.
+	std::sort(m_hits.begin(), m_hits.end(), [](const Hit& a, const Hit& b) { return std::less<const Material*>()(a.material, b.material); });
+
+	m_bounces.resize(m_hits.size());
+
+	for (size_t i = 0; i < m_hits.size(); i++)
+	{
+		const auto& hit = m_hits[i];
+		auto& path = m_paths[hit.path];
+		auto& bounce = m_bounces[i];
+
+		bounce.incident			= path.ray.direction();
+		bounce.position			= path.ray.at(hit.distance);
+		bounce.rayDepth			= path.rayDepth + 1;
+		bounce.emissionWeight	= scene.lights.emissionWeight(*hit.object, bounce.position, path.ray, path.scatterNormal, path.scatterPdf);
+		bounce.sequence			= path.sequence;
+		bounce.guide			= scene.guide.get();
+		bounce.photons			= scene.photons.get();
+		bounce.causticPath		= path.causticPath;
+
+		if (scene.photons && hit.material->isLight() && scene.photons->carries(path.ray, hit.distance, path.causticPath))
+			bounce.emissionWeight = 0;
+
+		hit.object->getSurfaceProperties(path.ray, bounce.position, bounce.normal, bounce.uv);
+
+		if (path.rayDepth == 0)
+			path.features = Features{ .albedo = hit.material->albedo(bounce.uv), .normal = bounce.normal, .depth = hit.distance, .object = hit.object };
+	}
+
+	for (size_t first = 0, last = 0; first < m_hits.size(); first = last)
+	{
+		while (last < m_hits.size() && m_hits[last].material == m_hits[first].material)
+			last++;
+
+		m_hits[first].material->bounceAll(scene.lights, std::span(m_bounces).subspan(first, last - first));
+	}
+}
+
+void WavefrontIntegrator::traceLightRays(const Scene& scene)
+{
+	for (size_t i = 0; i < m_hits.size(); i++)
+	{
+		auto& path = m_paths[m_hits[i].path];
+		const auto& bounce = m_bounces[i];
+
+		path.radiance += path.throughput * bounce.emitted;
+		gatherRadiance(path, bounce.emitted);
+
+		Color direct;
+
+		if (bounce.lightRay)
+		{
+			const Color emission = scene.lights.traceEmission(scene, bounce.light, *bounce.lightRay);
+
+			direct = bounce.lightWeight * emission;
+
+			path.radiance += path.throughput * direct;
+			gatherRadiance(path, direct);
+		}
+
+		// The light leaving a diffuse hit starts with what it emits and its direct light, and
+		// gathers the rest from the path's later hits. The vertex's throughput starts as white,
+		// and becomes the weight of its scattered ray as the path continues.
+		if (scene.cache && m_hits[i].material->isDiffuse())
+		{
+			m_cachedVertices.push_back(
+				{
+					.position	= bounce.position,
+					.normal		= bounce.normal,
+					.throughput	= Palette::kWhite,
+					.radiance	= bounce.emitted + direct,
+					.previous	= path.lastCachedVertex,
+				});
+
+			path.lastCachedVertex = m_cachedVertices.size() - 1;
+		}
+	}
+}
+
+void WavefrontIntegrator::queueContinuations()
+{
+	m_activePaths.clear();
+
+	for (size_t i = 0; i < m_hits.size(); i++)
+	{
+		auto& path = m_paths[m_hits[i].path];
+		const auto& bounce = m_bounces[i];
+
+		path.sequence = bounce.sequence;
+
+		// Queue the continuation of any path that wasn't absorbed, for the next bounce.
+		if (bounce.scatterRay)
+		{
+			path.ray			= *bounce.scatterRay;
+			path.throughput		*= bounce.weight;
+			path.rayDepth		= bounce.rayDepth;
+			path.scatterPdf		= bounce.scatterPdf;
+			path.scatterNormal	= bounce.normal;
+			path.causticPath	= bounce.scatterCausticPath;
+			path.afterDiffuse	= path.afterDiffuse || m_hits[i].material->isDiffuse();
+
+			for (size_t vertex = path.lastGuidedVertex; vertex != kNoVertex; vertex = m_guidedVertices[vertex].previous)
+				m_guidedVertices[vertex].throughput *= bounce.weight;
+
+			for (size_t vertex = path.lastCachedVertex; vertex != kNoVertex; vertex = m_cachedVertices[vertex].previous)
+				m_cachedVertices[vertex].throughput *= bounce.weight;
+
+			if (bounce.recordPdf > 0)
+			{
+				m_guidedVertices.push_back(
+					{
+						.position	= bounce.position,
+						.normal		= bounce.normal,
+						.direction	= bounce.scatterRay->direction(),
+						.pdf		= bounce.recordPdf,
+						.throughput	= Palette::kWhite,
+						.radiance	= Color(),
+						.previous	= path.lastGuidedVertex,
+					});
+
+				path.lastGuidedVertex = m_guidedVertices.size() - 1;
+			}
+
+			m_activePaths.push_back(m_hits[i].path);
+		}
+	}
+}
+
+void WavefrontIntegrator::gatherRadiance(const Path& path, const Color& radiance)
+{
+	// The light reaching the path also reaches each of its guided vertices, in proportion to
+	// the throughput of the path from the vertex on.
+	for (size_t vertex = path.lastGuidedVertex; vertex != kNoVertex; vertex = m_guidedVertices[vertex].previous)
+		m_guidedVertices[vertex].radiance += m_guidedVertices[vertex].throughput * radiance;
+
+	for (size_t vertex = path.lastCachedVertex; vertex != kNoVertex; vertex = m_cachedVertices[vertex].previous)
+		m_cachedVertices[vertex].radiance += m_cachedVertices[vertex].throughput * radiance;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Engine/Color.hpp"
+#include "Engine/Features.hpp"
+#include "Engine/Material.hpp"
+#include "Engine/PhotonMap.hpp"
+#include "Engine/Random.hpp"
+#include "Engine/Ray.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Object;
+
+struct Scene;
+
+// Traces a batch of paths breadth first. Each stage (finding the closest hits, shading
+// them, tracing shadow rays to sampled lights, and queueing the rays that continue) runs
+// over every active path before the next stage starts, rather than following one path at
+// a time to completion as Ray::trace does, so each stage's code and data stays hot in the
+// caches. Hits are shaded grouped by material, one batch per material.
+class WavefrontIntegrator
+{
+public:
+										WavefrontIntegrator() = default;
+
+	void								clear();
+	size_t								addPath(const Ray& ray);
+
+	void								trace(const Scene& scene);
+
+	const Color&						radiance(size_t path) const { return m_paths[path].radiance; }
+	const Features&						features(size_t path) const { return m_paths[path].features; }
+
+private:
+	static inline constexpr size_t kNoVertex = static_cast<size_t>(-1);
+
+	struct Path
+	{
+		Ray								ray;
+		Color							throughput;
+		Color							radiance;
+		Features						features;
+		Random::Sequence				sequence;
+		uint32_t						rayDepth = 0;
+		double							scatterPdf = 0;
+		Vector							scatterNormal = StandardVectors::kZero;
+		PhotonMap::CausticPath			causticPath = PhotonMap::CausticPath::None;
+		bool							afterDiffuse = false;
+		size_t							lastGuidedVertex = kNoVertex;
+		size_t							lastCachedVertex = kNoVertex;
+	};
+
+	// A point along a path where the path guide applies, gathering the light that arrives there
+	// along the path's next ray, to be recorded once the path is complete. The path's earlier
+	// such points are linked from each.
+	struct GuidedVertex
+	{
+		Vector							position;
+		Vector							normal;
+		Vector							direction;
+		double							pdf = 0;
+		Color							throughput;
+		Color							radiance;
+		size_t							previous = kNoVertex;
+	};
+
+	// A diffuse hit along a path when the radiance cache is enabled, gathering the light that
+	// leaves it back along the path, to be recorded in the cache once the path is complete.
+	struct CachedVertex
+	{
+		Vector							position;
+		Vector							normal;
+		Color							throughput;
+		Color							radiance;
+		size_t							previous = kNoVertex;
+	};
+
+	struct Hit
+	{
+		size_t							path = 0;
+		const Object*					object = nullptr;
+		Material*						material = nullptr;
+		double							distance = 0;
+	};
+
+	void								findClosestHits(const Scene& scene);
+	void								shadeHits(const Scene& scene);
+	void								traceLightRays(const Scene& scene);
+	void								queueContinuations();
+	void								gatherRadiance(const Path& path, const Color& radiance);
+
+private:
+	std::vector<Path>					m_paths;
+	std::vector<size_t>					m_activePaths;
+	std::vector<Hit>					m_hits;
+	std::vector<Material::Bounce>		m_bounces;
+	std::vector<GuidedVertex>			m_guidedVertices;
+	std::vector<CachedVertex>			m_cachedVertices;
+};
@@ -1,13 +1,95 @@
-﻿#include "Viewer.hpp"
+﻿#include "RandomBenchmark.hpp"
+#include "ScalingReport.hpp"
+#include "Viewer.hpp"
+
+#include "Engine/ThreadPlacement.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
 
 namespace
 {
 	constexpr size_t kWidth	 = 1920;
 	constexpr size_t kHeight = 1080;
+
+	constexpr size_t kScalingReportWidth	= 480;
+	constexpr size_t kScalingReportHeight	= 270;
+
+	constexpr size_t kRandomBenchmarkSamples	= 4000000;
+
+	void PrintUsage(const char* program)
+	{
+		printf("Usage: %s [--threads COUNT] [--affinity none|compact|scatter] [--scaling-report] [--random-benchmark] [SCENE]\n", program);
+	}
 }
 
 int main(int argc, char* argv[])
 {
-	Viewer viewer(kWidth, kHeight);
-	viewer.view("Assets/Scene.yaml");
+	std::string scenePath = "Assets/Scene.yaml";
+	size_t numRenderThreads = std::thread::hardware_concurrency();
+	ThreadAffinity affinity = ThreadAffinity::None;
+	bool scalingReport = false;
+	bool randomBenchmark = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string argument = argv[i];
+
+		if (argument == "--threads" && (i + 1) < argc)
+		{
+			numRenderThreads = std::strtoul(argv[++i], nullptr, 10);
+		}
+		else if (argument == "--affinity" && (i + 1) < argc)
+		{
+			const auto parsedAffinity = ThreadPlacement::ParseAffinity(argv[++i]);
+			if (! parsedAffinity)
+			{
+				PrintUsage(argv[0]);
+				return EXIT_FAILURE;
+			}
+
+			affinity = *parsedAffinity;
+		}
+		else if (argument == "--scaling-report")
+		{
+			scalingReport = true;
+		}
+		else if (argument == "--random-benchmark")
+		{
+			randomBenchmark = true;
+		}
+		else if (! argument.starts_with("--"))
+		{
+			scenePath = argument;
+		}
+		else
+		{
+			PrintUsage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (! numRenderThreads)
+	{
+		PrintUsage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if (scalingReport)
+	{
+		ScalingReport report(kScalingReportWidth, kScalingReportHeight, numRenderThreads);
+		return report.run(scenePath) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	if (randomBenchmark)
+	{
+		RandomBenchmark benchmark(kRandomBenchmarkSamples);
+		benchmark.run();
+		return EXIT_SUCCESS;
+	}
+
+	Viewer viewer(kWidth, kHeight, numRenderThreads, affinity);
+	viewer.view(scenePath);
 }
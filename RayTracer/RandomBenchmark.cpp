@@ -0,0 +1,92 @@
+#include "RandomBenchmark.hpp"
+
+#include "Engine/Random.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace
+{
+	constexpr uint32_t kWidth	= 1024;
+	constexpr uint64_t kSeed	= 0x5EED5EED5EED5EEDull;
+
+	constexpr size_t kBlockSize	= static_cast<size_t>(Random::BounceDimension::Count);
+	constexpr int kRepeats		= 5;
+
+	// Runs the generator over every sample, returning the fastest of several runs (in
+	// nanoseconds per number) and the sum of the numbers, so they can't be optimized away.
+	template <typename Generator>
+	double Time(size_t numSamples, Generator&& generator, double& sum)
+	{
+		double fastest = 0;
+
+		for (int repeat = 0; repeat < kRepeats; repeat++)
+		{
+			const auto start = std::chrono::steady_clock::now();
+
+			std::array<double, kBlockSize> block;
+			sum = 0;
+
+			for (size_t sample = 0; sample < numSamples; sample++)
+			{
+				const auto x		= static_cast<uint32_t>(sample % kWidth);
+				const auto y		= static_cast<uint32_t>(sample / kWidth);
+				const auto bounce	= static_cast<uint32_t>(sample % 8);
+
+				generator(block, x, y, static_cast<uint32_t>(Random::CameraDimension::Count) + (bounce * kBlockSize));
+
+				for (const double value : block)
+					sum += value;
+			}
+
+			const double time = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (numSamples * kBlockSize);
+			if (! repeat || time < fastest)
+				fastest = time;
+		}
+
+		return fastest;
+	}
+}
+
+RandomBenchmark::RandomBenchmark(size_t numSamples)
+	: m_numSamples(numSamples)
+{
+
+}
+
+void RandomBenchmark::run()
+{
+	printf("Random number benchmark (%zu bounces of %zu numbers)\n\n", m_numSamples, kBlockSize);
+	printf("%-10s %14s %10s %14s\n", "Method", "Time (ns/num)", "Speedup", "Mean");
+
+	// Each Philox call gives the numbers for a pair of dimensions, so the scalar baseline makes
+	// one call per pair and keeps both, leaving only the batching of the calls to be compared.
+	double perCallSum = 0;
+	const double perCallTime = Time(m_numSamples,
+		[](std::array<double, kBlockSize>& block, uint32_t x, uint32_t y, uint32_t firstDimension)
+		{
+			for (uint32_t dimension = 0; dimension < kBlockSize; dimension += 2)
+			{
+				const auto bits = Random::Philox({ x, y, 0, (firstDimension + dimension) / 2 }, Random::PhiloxKey(kSeed));
+
+				block[dimension]		= Random::ToUnitInterval(bits[0], bits[1]);
+				block[dimension + 1]	= Random::ToUnitInterval(bits[2], bits[3]);
+			}
+		},
+		perCallSum);
+
+	double blockSum = 0;
+	const double blockTime = Time(m_numSamples,
+		[](std::array<double, kBlockSize>& block, uint32_t x, uint32_t y, uint32_t firstDimension)
+		{
+			Random::FillIndependent(block, x, y, 0, firstDimension, kSeed);
+		},
+		blockSum);
+
+	const double count = static_cast<double>(m_numSamples * kBlockSize);
+
+	printf("%-10s %14.2f %9.2fx %14.6f\n", "Per pair", perCallTime, 1.0, perCallSum / count);
+	printf("%-10s %14.2f %9.2fx %14.6f\n", "Block", blockTime, perCallTime / blockTime, blockSum / count);
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+
+// Times generating the independent random numbers for a bounce one at a time, against
+// generating them a block at a time with Random::FillIndependent().
+class RandomBenchmark
+{
+public:
+	explicit			RandomBenchmark(size_t numSamples);
+
+	void				run();
+
+private:
+	size_t				m_numSamples;
+};
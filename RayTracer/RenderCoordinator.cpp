@@ -0,0 +1,369 @@
+#include "RenderCoordinator.hpp"
+#include "SceneLoader.hpp"
+
+#include "Engine/Image.hpp"
+#include "Engine/Scene.hpp"
+
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Packet.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+
+namespace
+{
+	constexpr size_t kTileSize = 64;
+	constexpr auto kPollInterval = std::chrono::milliseconds(100);
+
+	// A tile is handed to another worker if it takes much longer than the average tile,
+	// which covers both workers that are slow and ones that have hung without disconnecting.
+	constexpr auto kInitialTileTimeout = std::chrono::milliseconds(60000);
+	constexpr auto kMinTileTimeout = std::chrono::milliseconds(10000);
+	constexpr int kSlowTileFactor = 4;
+
+	constexpr int kProgressReportPercentage = 10;
+}
+
+RenderCoordinator::RenderCoordinator(const BatchRenderer::Options& options, uint16_t port)
+	: m_options(options)
+	, m_port(port)
+{
+
+}
+
+BatchRenderer::ExitCode RenderCoordinator::run()
+{
+	SceneLoader sceneLoader;
+
+	Scene scene;
+
+	try
+	{
+		scene = sceneLoader.load(m_options.scenePath);
+	}
+	catch (const std::exception& e)
+	{
+		fprintf(stderr, "Failed to parse scene file: %s\n", e.what());
+		return BatchRenderer::ExitCode::SceneLoadFailed;
+	}
+
+	if ((m_options.width * m_options.height) > RenderProtocol::kMaxFramePixels)
+	{
+		fprintf(stderr, "Resolution %zux%zu is too large to distribute to workers\n", m_options.width, m_options.height);
+		return BatchRenderer::ExitCode::InvalidArguments;
+	}
+
+	// Workers render every tile from the scene's camera, so the frames of a sequence can't be distributed.
+	if (! scene.sequence.empty())
+	{
+		fprintf(stderr, "Scene sequences can't be rendered with --coordinator\n");
+		return BatchRenderer::ExitCode::InvalidArguments;
+	}
+
+	m_sceneHash = SceneLoader::HashFile(m_options.scenePath);
+
+	if (m_listener.listen(m_port) != sf::Socket::Done)
+	{
+		fprintf(stderr, "Failed to listen for workers on port %u\n", m_port);
+		return BatchRenderer::ExitCode::NetworkFailed;
+	}
+
+	m_selector.add(m_listener);
+
+	createTiles(m_options.samplesPerPixel.value_or(scene.samplesPerPixel));
+	m_pixels.assign(m_options.width * m_options.height, Palette::kBlack.toRGBA8888());
+
+	printf("Rendering '%s' at %zux%zu, %u samples/pixel, %zu tiles\n", m_options.scenePath.c_str(), m_options.width, m_options.height, m_tiles.front().tile.samplesPerPixel, m_tiles.size());
+	printf("Waiting for workers on port %u\n", m_port);
+
+	const auto renderStartTime = std::chrono::steady_clock::now();
+	int lastRenderPercent = 0;
+
+	while (m_completedTiles < m_tiles.size())
+	{
+		if (m_selector.wait(sf::milliseconds(static_cast<sf::Int32>(kPollInterval.count()))))
+		{
+			if (m_selector.isReady(m_listener))
+				acceptWorker();
+
+			for (auto& worker : m_workers)
+			{
+				if (worker.connected && m_selector.isReady(worker.socket) && ! receiveMessage(worker))
+					removeWorker(worker);
+			}
+		}
+
+		reassignSlowTiles();
+		assignTiles();
+
+		m_workers.remove_if([](const Worker& worker) { return ! worker.connected; });
+
+		const int renderPercent = static_cast<int>(100 * m_completedTiles / m_tiles.size());
+		if ((renderPercent / kProgressReportPercentage) != (lastRenderPercent / kProgressReportPercentage))
+		{
+			lastRenderPercent = renderPercent;
+			printf("Rendering... %3d%% (%zu workers)\n", renderPercent, m_workers.size());
+		}
+	}
+
+	const auto renderTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - renderStartTime);
+	printf("Render completed in %lld ms\n", static_cast<long long>(renderTime.count()));
+
+	for (auto& worker : m_workers)
+	{
+		sf::Packet packet;
+		packet << RenderProtocol::MessageType::Finish;
+
+		worker.socket.send(packet);
+		worker.socket.disconnect();
+	}
+
+	if (! saveImage(m_options.outputPath))
+	{
+		fprintf(stderr, "Failed to save image to '%s'\n", m_options.outputPath.c_str());
+		return BatchRenderer::ExitCode::ImageSaveFailed;
+	}
+
+	printf("Saved image to '%s'\n", m_options.outputPath.c_str());
+	return BatchRenderer::ExitCode::Success;
+}
+
+void RenderCoordinator::createTiles(uint32_t samplesPerPixel)
+{
+	for (size_t y = 0; y < m_options.height; y += kTileSize)
+	{
+		for (size_t x = 0; x < m_options.width; x += kTileSize)
+		{
+			const uint32_t tileId = static_cast<uint32_t>(m_tiles.size());
+
+			m_tiles.push_back(
+				{
+					.tile =
+						{
+							.id					= tileId,
+							.frameWidth			= static_cast<uint32_t>(m_options.width),
+							.frameHeight		= static_cast<uint32_t>(m_options.height),
+							.samplesPerPixel	= samplesPerPixel,
+							.region				= { .x = x, .y = y, .width = std::min(kTileSize, m_options.width - x), .height = std::min(kTileSize, m_options.height - y) }
+						}
+				});
+
+			m_pendingTiles.push_back(tileId);
+		}
+	}
+}
+
+void RenderCoordinator::acceptWorker()
+{
+	auto& worker = m_workers.emplace_back();
+
+	if (m_listener.accept(worker.socket) != sf::Socket::Done)
+	{
+		m_workers.pop_back();
+		return;
+	}
+
+	worker.id = m_nextWorkerId++;
+	worker.name = worker.socket.getRemoteAddress().toString() + ":" + std::to_string(worker.socket.getRemotePort());
+
+	// Workers' sockets don't block, so one that stalls partway through sending a message can't
+	// hold up the others; the rest of its message is received once it arrives.
+	worker.socket.setBlocking(false);
+
+	m_selector.add(worker.socket);
+
+	printf("Worker %s connected\n", worker.name.c_str());
+}
+
+bool RenderCoordinator::receiveMessage(Worker& worker)
+{
+	// The socket keeps whatever part of a message has arrived until the rest of it does.
+	sf::Packet packet;
+	const sf::Socket::Status status = worker.socket.receive(packet);
+
+	if (status == sf::Socket::Partial || status == sf::Socket::NotReady)
+		return true;
+
+	if (status != sf::Socket::Done)
+	{
+		printf("Worker %s disconnected\n", worker.name.c_str());
+		return false;
+	}
+
+	RenderProtocol::MessageType messageType;
+	packet >> messageType;
+
+	if (messageType == RenderProtocol::MessageType::Hello && ! worker.ready)
+		return handleHello(worker, packet);
+	else if (messageType == RenderProtocol::MessageType::TileResult && worker.ready)
+		return handleTileResult(worker, packet);
+
+	fprintf(stderr, "Received invalid message from worker %s\n", worker.name.c_str());
+	return false;
+}
+
+bool RenderCoordinator::handleHello(Worker& worker, sf::Packet& packet)
+{
+	RenderProtocol::Hello hello;
+	if (! (packet >> hello) || hello.version != RenderProtocol::kVersion)
+	{
+		fprintf(stderr, "Worker %s uses an incompatible protocol version\n", worker.name.c_str());
+		return false;
+	}
+
+	if (hello.sceneHash != m_sceneHash)
+	{
+		fprintf(stderr, "Worker %s has loaded a different scene file\n", worker.name.c_str());
+		return false;
+	}
+
+	worker.ready = true;
+	return true;
+}
+
+bool RenderCoordinator::handleTileResult(Worker& worker, sf::Packet& packet)
+{
+	RenderProtocol::TileResult tileResult;
+	packet >> tileResult;
+
+	if (! packet || tileResult.id >= m_tiles.size())
+	{
+		fprintf(stderr, "Received invalid tile from worker %s\n", worker.name.c_str());
+		return false;
+	}
+
+	auto& tileInfo = m_tiles[tileResult.id];
+	const auto& region = tileInfo.tile.region;
+
+	if (tileResult.samples.size() != (region.width * region.height))
+	{
+		fprintf(stderr, "Received tile %u with the wrong size from worker %s\n", tileResult.id, worker.name.c_str());
+		return false;
+	}
+
+	// Only the worker holding the tile may return it, whether the tile is still assigned to it
+	// or has been reassigned since; a result for any other tile is dropped.
+	if (worker.tileId != tileResult.id)
+	{
+		fprintf(stderr, "Dropped tile %u from worker %s, which wasn't assigned it\n", tileResult.id, worker.name.c_str());
+		return true;
+	}
+
+	worker.tileId.reset();
+
+	// A tile that was reassigned may be returned by both workers; the first one wins.
+	if (tileInfo.state == TileState::Complete)
+		return true;
+
+	for (size_t y = 0; y < region.height; y++)
+	{
+		for (size_t x = 0; x < region.width; x++)
+		{
+			const size_t currentPixel = ((region.y + y) * m_options.width) + (region.x + x);
+			m_pixels[currentPixel] = tileResult.samples[(y * region.width) + x].clamped().toRGBA8888();
+		}
+	}
+
+	m_completedTileTime += std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - worker.tileAssignedTime);
+
+	tileInfo.state = TileState::Complete;
+	m_completedTiles++;
+
+	return true;
+}
+
+void RenderCoordinator::removeWorker(Worker& worker)
+{
+	// Put the worker's tile back at the front of the queue for the next free worker,
+	// unless it has already been reassigned to someone else.
+	if (worker.tileId)
+	{
+		auto& tileInfo = m_tiles[*worker.tileId];
+
+		if (tileInfo.state == TileState::Assigned && tileInfo.workerId == worker.id)
+		{
+			tileInfo.state = TileState::Pending;
+			m_pendingTiles.push_front(*worker.tileId);
+		}
+	}
+
+	m_selector.remove(worker.socket);
+	worker.socket.disconnect();
+	worker.connected = false;
+}
+
+void RenderCoordinator::reassignSlowTiles()
+{
+	const auto now = std::chrono::steady_clock::now();
+	const auto timeout = tileTimeout();
+
+	for (auto& tileInfo : m_tiles)
+	{
+		if (tileInfo.state != TileState::Assigned || (now - tileInfo.assignedTime) < timeout)
+			continue;
+
+		// The original worker keeps going, so whichever of them finishes first completes the tile.
+		printf("Tile %u is overdue, reassigning\n", tileInfo.tile.id);
+
+		tileInfo.state = TileState::Pending;
+		m_pendingTiles.push_front(tileInfo.tile.id);
+	}
+}
+
+void RenderCoordinator::assignTiles()
+{
+	for (auto& worker : m_workers)
+	{
+		if (! worker.connected || ! worker.ready || worker.tileId)
+			continue;
+
+		// Skip over any queued tiles that were completed after they were queued for reassignment.
+		while (! m_pendingTiles.empty() && m_tiles[m_pendingTiles.front()].state != TileState::Pending)
+			m_pendingTiles.pop_front();
+
+		if (m_pendingTiles.empty())
+			break;
+
+		auto& tileInfo = m_tiles[m_pendingTiles.front()];
+		m_pendingTiles.pop_front();
+
+		sf::Packet packet;
+		packet << RenderProtocol::MessageType::Tile << tileInfo.tile;
+
+		// Workers are only sent a tile once they've returned their last one, so the little
+		// message always fits in the socket's buffer, even though the socket doesn't block.
+		if (worker.socket.send(packet) != sf::Socket::Done)
+		{
+			m_pendingTiles.push_front(tileInfo.tile.id);
+			removeWorker(worker);
+			continue;
+		}
+
+		tileInfo.state = TileState::Assigned;
+		tileInfo.workerId = worker.id;
+		tileInfo.assignedTime = std::chrono::steady_clock::now();
+
+		worker.tileId = tileInfo.tile.id;
+		worker.tileAssignedTime = tileInfo.assignedTime;
+	}
+}
+
+std::chrono::milliseconds RenderCoordinator::tileTimeout() const
+{
+	if (! m_completedTiles)
+		return kInitialTileTimeout;
+
+	const auto averageTileTime = m_completedTileTime / static_cast<int64_t>(m_completedTiles);
+	return std::max(kMinTileTimeout, averageTileTime * kSlowTileFactor);
+}
+
+bool RenderCoordinator::saveImage(const std::string& path)
+{
+	Image image;
+	image.width		= static_cast<uint32_t>(m_options.width);
+	image.height	= static_cast<uint32_t>(m_options.height);
+	image.pixels	= m_pixels;
+
+	return image.save(path);
+}
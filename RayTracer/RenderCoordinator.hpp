@@ -0,0 +1,79 @@
+#pragma once
+
+#include "BatchRenderer.hpp"
+#include "RenderProtocol.hpp"
+
+#include <SFML/Network/SocketSelector.hpp>
+#include <SFML/Network/TcpListener.hpp>
+#include <SFML/Network/TcpSocket.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <optional>
+#include <string>
+#include <vector>
+
+class RenderCoordinator
+{
+public:
+							RenderCoordinator(const BatchRenderer::Options& options, uint16_t port);
+
+	BatchRenderer::ExitCode	run();
+
+private:
+	enum class TileState { Pending, Assigned, Complete };
+
+	struct TileInfo
+	{
+		RenderProtocol::Tile					tile;
+		TileState								state = TileState::Pending;
+		uint64_t								workerId = 0;
+		std::chrono::steady_clock::time_point	assignedTime = {};
+	};
+
+	struct Worker
+	{
+		uint64_t								id = 0;
+		std::string								name;
+		sf::TcpSocket							socket;
+		bool									connected = true;
+		bool									ready = false;
+		std::optional<uint32_t>					tileId;
+		std::chrono::steady_clock::time_point	tileAssignedTime = {};
+	};
+
+	void					createTiles(uint32_t samplesPerPixel);
+
+	void					acceptWorker();
+	bool					receiveMessage(Worker& worker);
+	bool					handleHello(Worker& worker, sf::Packet& packet);
+	bool					handleTileResult(Worker& worker, sf::Packet& packet);
+	void					removeWorker(Worker& worker);
+
+	void					reassignSlowTiles();
+	void					assignTiles();
+	std::chrono::milliseconds	tileTimeout() const;
+
+	bool					saveImage(const std::string& path);
+
+private:
+	BatchRenderer::Options	m_options;
+	uint16_t				m_port = 0;
+	uint64_t				m_sceneHash = 0;
+
+	sf::TcpListener			m_listener;
+	sf::SocketSelector		m_selector;
+
+	std::list<Worker>		m_workers;
+	uint64_t				m_nextWorkerId = 1;
+
+	std::vector<TileInfo>	m_tiles;
+	std::deque<uint32_t>	m_pendingTiles;
+	size_t					m_completedTiles = 0;
+	std::chrono::milliseconds	m_completedTileTime = {};
+
+	std::vector<uint32_t>	m_pixels;
+};
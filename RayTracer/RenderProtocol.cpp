@@ -0,0 +1,105 @@
+#include "RenderProtocol.hpp"
+
+namespace
+{
+	// Largest tile we'll accept, to bound allocations from malformed packets.
+	constexpr uint32_t kMaxTilePixels = 4096 * 4096;
+}
+
+namespace RenderProtocol
+{
+	sf::Packet& operator<<(sf::Packet& packet, MessageType type)
+	{
+		return packet << static_cast<sf::Uint8>(type);
+	}
+
+	sf::Packet& operator>>(sf::Packet& packet, MessageType& type)
+	{
+		sf::Uint8 value = 0;
+		packet >> value;
+
+		type = static_cast<MessageType>(value);
+		return packet;
+	}
+
+	sf::Packet& operator<<(sf::Packet& packet, const Hello& hello)
+	{
+		return packet << static_cast<sf::Uint32>(hello.version) << static_cast<sf::Uint64>(hello.sceneHash);
+	}
+
+	sf::Packet& operator>>(sf::Packet& packet, Hello& hello)
+	{
+		sf::Uint32 version = 0;
+		sf::Uint64 sceneHash = 0;
+		packet >> version >> sceneHash;
+
+		hello.version = version;
+		hello.sceneHash = sceneHash;
+		return packet;
+	}
+
+	sf::Packet& operator<<(sf::Packet& packet, const Tile& tile)
+	{
+		return packet
+			<< static_cast<sf::Uint32>(tile.id)
+			<< static_cast<sf::Uint32>(tile.frameWidth)
+			<< static_cast<sf::Uint32>(tile.frameHeight)
+			<< static_cast<sf::Uint32>(tile.samplesPerPixel)
+			<< static_cast<sf::Uint32>(tile.region.x)
+			<< static_cast<sf::Uint32>(tile.region.y)
+			<< static_cast<sf::Uint32>(tile.region.width)
+			<< static_cast<sf::Uint32>(tile.region.height);
+	}
+
+	sf::Packet& operator>>(sf::Packet& packet, Tile& tile)
+	{
+		sf::Uint32 values[8] = {};
+
+		for (auto& value : values)
+			packet >> value;
+
+		tile.id					= values[0];
+		tile.frameWidth			= values[1];
+		tile.frameHeight		= values[2];
+		tile.samplesPerPixel	= values[3];
+		tile.region				= { .x = values[4], .y = values[5], .width = values[6], .height = values[7] };
+		return packet;
+	}
+
+	sf::Packet& operator<<(sf::Packet& packet, const TileResult& tileResult)
+	{
+		packet << static_cast<sf::Uint32>(tileResult.id) << static_cast<sf::Uint32>(tileResult.samples.size());
+
+		// Samples are sent as linear floating point color, so no precision is lost to
+		// 8-bit quantization until the coordinator assembles the final image.
+		for (const auto& sample : tileResult.samples)
+			packet << static_cast<float>(sample.red()) << static_cast<float>(sample.green()) << static_cast<float>(sample.blue());
+
+		return packet;
+	}
+
+	sf::Packet& operator>>(sf::Packet& packet, TileResult& tileResult)
+	{
+		sf::Uint32 id = 0;
+		sf::Uint32 numSamples = 0;
+		packet >> id >> numSamples;
+
+		tileResult.id = id;
+		tileResult.samples.clear();
+
+		if (! packet || numSamples > kMaxTilePixels)
+			return packet;
+
+		tileResult.samples.reserve(numSamples);
+
+		for (sf::Uint32 i = 0; i < numSamples && packet; i++)
+		{
+			float red = 0, green = 0, blue = 0;
+			packet >> red >> green >> blue;
+
+			tileResult.samples.emplace_back(red, green, blue);
+		}
+
+		return packet;
+	}
+}
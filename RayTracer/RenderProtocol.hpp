@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Engine/Color.hpp"
+#include "Engine/Renderer.hpp"
+
+#include <SFML/Network/Packet.hpp>
+
+#include <cstdint>
+#include <vector>
+
+// Messages exchanged over TCP between a RenderCoordinator and its RenderWorkers.
+namespace RenderProtocol
+{
+	constexpr uint32_t kVersion = 1;
+
+	// Largest frame a worker will render, as each worker allocates a renderer for the whole frame.
+	constexpr uint64_t kMaxFramePixels = 8192 * 8192;
+
+	enum class MessageType : uint8_t
+	{
+		Hello,			// Worker -> coordinator, once connected
+		Tile,			// Coordinator -> worker, a tile of the frame to render
+		TileResult,		// Worker -> coordinator, the rendered tile's samples
+		Finish,			// Coordinator -> worker, the frame is complete
+	};
+
+	struct Hello
+	{
+		uint32_t					version = kVersion;
+		uint64_t					sceneHash = 0;
+	};
+
+	struct Tile
+	{
+		uint32_t					id = 0;
+		uint32_t					frameWidth = 0;
+		uint32_t					frameHeight = 0;
+		uint32_t					samplesPerPixel = 0;
+		Renderer::Region			region;
+	};
+
+	struct TileResult
+	{
+		uint32_t					id = 0;
+		std::vector<Color>			samples;
+	};
+
+	sf::Packet&						operator<<(sf::Packet& packet, MessageType type);
+	sf::Packet&						operator>>(sf::Packet& packet, MessageType& type);
+
+	sf::Packet&						operator<<(sf::Packet& packet, const Hello& hello);
+	sf::Packet&						operator>>(sf::Packet& packet, Hello& hello);
+
+	sf::Packet&						operator<<(sf::Packet& packet, const Tile& tile);
+	sf::Packet&						operator>>(sf::Packet& packet, Tile& tile);
+
+	sf::Packet&						operator<<(sf::Packet& packet, const TileResult& tileResult);
+	sf::Packet&						operator>>(sf::Packet& packet, TileResult& tileResult);
+}
@@ -0,0 +1,141 @@
+#include "RenderWorker.hpp"
+#include "SceneLoader.hpp"
+
+#include <SFML/Network/IpAddress.hpp>
+#include <SFML/Network/Packet.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <thread>
+
+namespace
+{
+	constexpr int kConnectAttempts = 10;
+	constexpr auto kConnectRetryInterval = std::chrono::seconds(1);
+	constexpr auto kConnectTimeout = std::chrono::milliseconds(5000);
+
+	bool IsValidTile(const RenderProtocol::Tile& tile)
+	{
+		return
+			(static_cast<uint64_t>(tile.frameWidth) * tile.frameHeight) <= RenderProtocol::kMaxFramePixels &&
+			tile.region.width && tile.region.height &&
+			(tile.region.x + tile.region.width) <= tile.frameWidth &&
+			(tile.region.y + tile.region.height) <= tile.frameHeight;
+	}
+}
+
+RenderWorker::RenderWorker(const BatchRenderer::Options& options, const std::string& coordinatorAddress, uint16_t coordinatorPort)
+	: m_options(options)
+	, m_coordinatorAddress(coordinatorAddress)
+	, m_coordinatorPort(coordinatorPort)
+{
+
+}
+
+BatchRenderer::ExitCode RenderWorker::run()
+{
+	SceneLoader sceneLoader;
+
+	try
+	{
+		m_scene = sceneLoader.load(m_options.scenePath);
+	}
+	catch (const std::exception& e)
+	{
+		fprintf(stderr, "Failed to parse scene file: %s\n", e.what());
+		return BatchRenderer::ExitCode::SceneLoadFailed;
+	}
+
+	if (! connect())
+		return BatchRenderer::ExitCode::NetworkFailed;
+
+	sf::Packet helloPacket;
+	helloPacket << RenderProtocol::MessageType::Hello << RenderProtocol::Hello{ .sceneHash = SceneLoader::HashFile(m_options.scenePath) };
+
+	if (m_socket.send(helloPacket) != sf::Socket::Done)
+	{
+		fprintf(stderr, "Failed to send hello to coordinator\n");
+		return BatchRenderer::ExitCode::NetworkFailed;
+	}
+
+	size_t numRenderedTiles = 0;
+
+	while (true)
+	{
+		sf::Packet packet;
+		if (m_socket.receive(packet) != sf::Socket::Done)
+		{
+			// The coordinator drops workers that it can't use, e.g. those with a different scene.
+			fprintf(stderr, "Lost connection to coordinator\n");
+			return BatchRenderer::ExitCode::NetworkFailed;
+		}
+
+		RenderProtocol::MessageType messageType;
+		packet >> messageType;
+
+		if (messageType == RenderProtocol::MessageType::Finish)
+		{
+			printf("Frame complete, rendered %zu tiles\n", numRenderedTiles);
+			return BatchRenderer::ExitCode::Success;
+		}
+
+		RenderProtocol::Tile tile;
+		if (messageType != RenderProtocol::MessageType::Tile || ! (packet >> tile) || ! IsValidTile(tile))
+		{
+			fprintf(stderr, "Received invalid message from coordinator\n");
+			return BatchRenderer::ExitCode::NetworkFailed;
+		}
+
+		if (! renderTile(tile))
+			return BatchRenderer::ExitCode::NetworkFailed;
+
+		numRenderedTiles++;
+	}
+}
+
+bool RenderWorker::connect()
+{
+	// Workers may well be started before the coordinator is listening, so keep
+	// retrying for a little while.
+	for (int attempt = 1; attempt <= kConnectAttempts; attempt++)
+	{
+		if (m_socket.connect(sf::IpAddress(m_coordinatorAddress), m_coordinatorPort, sf::milliseconds(static_cast<sf::Int32>(kConnectTimeout.count()))) == sf::Socket::Done)
+		{
+			printf("Connected to coordinator at %s:%u\n", m_coordinatorAddress.c_str(), m_coordinatorPort);
+			return true;
+		}
+
+		std::this_thread::sleep_for(kConnectRetryInterval);
+	}
+
+	fprintf(stderr, "Failed to connect to coordinator at %s:%u\n", m_coordinatorAddress.c_str(), m_coordinatorPort);
+	return false;
+}
+
+bool RenderWorker::renderTile(const RenderProtocol::Tile& tile)
+{
+	// The renderer is only recreated if the coordinator changes frame size.
+	if (! m_renderer || m_renderer->width() != tile.frameWidth || m_renderer->height() != tile.frameHeight)
+	{
+		m_renderer = std::make_unique<Renderer>(tile.frameWidth, tile.frameHeight, m_options.numRenderThreads, m_options.affinity);
+		m_renderer->setScene(m_scene);
+	}
+
+	m_renderer->setRegion(tile.region, tile.samplesPerPixel);
+	m_renderer->startRender();
+	m_renderer->waitForRenderCompletion();
+
+	printf("Rendered tile %u (%zux%zu at %zu,%zu) in %lld ms\n", tile.id, tile.region.width, tile.region.height, tile.region.x, tile.region.y, static_cast<long long>(m_renderer->renderTime().count()));
+
+	sf::Packet packet;
+	packet << RenderProtocol::MessageType::TileResult << RenderProtocol::TileResult{ .id = tile.id, .samples = m_renderer->samples(tile.region) };
+
+	if (m_socket.send(packet) != sf::Socket::Done)
+	{
+		fprintf(stderr, "Failed to send tile %u to coordinator\n", tile.id);
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "BatchRenderer.hpp"
+#include "RenderProtocol.hpp"
+
+#include "Engine/Renderer.hpp"
+#include "Engine/Scene.hpp"
+
+#include <SFML/Network/TcpSocket.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class RenderWorker
+{
+public:
+							RenderWorker(const BatchRenderer::Options& options, const std::string& coordinatorAddress, uint16_t coordinatorPort);
+
+	BatchRenderer::ExitCode	run();
+
+private:
+	bool					connect();
+	bool					renderTile(const RenderProtocol::Tile& tile);
+
+private:
+	BatchRenderer::Options	m_options;
+	std::string				m_coordinatorAddress;
+	uint16_t				m_coordinatorPort = 0;
+
+	Scene					m_scene;
+	sf::TcpSocket			m_socket;
+
+	std::unique_ptr<Renderer>	m_renderer;
+};
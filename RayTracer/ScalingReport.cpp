@@ -0,0 +1,89 @@
+#include "ScalingReport.hpp"
+#include "SceneLoader.hpp"
+
+#include "Engine/Renderer.hpp"
+#include "Engine/Scene.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <utility>
+
+namespace
+{
+	constexpr uint32_t kScalingReportSamplesPerPixel = 4;
+}
+
+ScalingReport::ScalingReport(size_t width, size_t height, size_t maxRenderThreads)
+	: m_width(width)
+	, m_height(height)
+	, m_maxRenderThreads(std::max<size_t>(maxRenderThreads, 1))
+{
+
+}
+
+bool ScalingReport::run(const std::string& path)
+{
+	SceneLoader sceneLoader;
+
+	Scene scene;
+
+	try
+	{
+		scene = sceneLoader.load(path);
+	}
+	catch (const std::exception& e)
+	{
+		fprintf(stderr, "Failed to parse scene file: %s\n", e.what());
+		return false;
+	}
+
+	scene.samplesPerPixel = kScalingReportSamplesPerPixel;
+
+	static const std::pair<ThreadAffinity, const char*> kAffinities[] =
+		{
+			{ ThreadAffinity::None,		"None" },
+			{ ThreadAffinity::Compact,	"Compact" },
+			{ ThreadAffinity::Scatter,	"Scatter" },
+		};
+
+	printf("Scaling report for '%s' (%zux%zu, %u samples/pixel)\n\n", path.c_str(), m_width, m_height, scene.samplesPerPixel);
+	printf("%-10s %8s %12s %10s %12s\n", "Affinity", "Threads", "Time (ms)", "Speedup", "Efficiency");
+
+	// All timings are compared against a single unpinned render thread.
+	double baselineTime = 0;
+
+	for (const auto& [affinity, affinityName] : kAffinities)
+	{
+		for (const size_t numRenderThreads : threadCounts())
+		{
+			Renderer renderer(m_width, m_height, numRenderThreads, affinity);
+			renderer.setScene(scene);
+			renderer.startRender();
+			renderer.waitForRenderCompletion();
+
+			const double renderTime = static_cast<double>(std::max<int64_t>(renderer.renderTime().count(), 1));
+			if (! baselineTime)
+				baselineTime = renderTime;
+
+			const double speedup = baselineTime / renderTime;
+
+			printf("%-10s %8zu %12.0f %9.2fx %11.1f%%\n", affinityName, numRenderThreads, renderTime, speedup, 100 * speedup / numRenderThreads);
+		}
+	}
+
+	return true;
+}
+
+std::vector<size_t> ScalingReport::threadCounts() const
+{
+	std::vector<size_t> counts;
+
+	for (size_t count = 1; count < m_maxRenderThreads; count *= 2)
+		counts.push_back(count);
+
+	counts.push_back(m_maxRenderThreads);
+
+	return counts;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Engine/ThreadPlacement.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class ScalingReport
+{
+public:
+						ScalingReport(size_t width, size_t height, size_t maxRenderThreads);
+
+	// Returns false if the scene can't be loaded.
+	bool				run(const std::string& path);
+
+private:
+	std::vector<size_t>	threadCounts() const;
+
+private:
+	size_t				m_width;
+	size_t				m_height;
+	size_t				m_maxRenderThreads;
+};
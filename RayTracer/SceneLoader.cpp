@@ -1,5 +1,6 @@
 #include "SceneLoader.hpp"
 
+#include "Engine/Image.hpp"
 #include "Engine/MathUtil.hpp"
 #include "Engine/Material/DebugMaterial.hpp"
 #include "Engine/Material/DielectricMaterial.hpp"
@@ -10,12 +11,12 @@
 #include "Engine/Object/MeshObject.hpp"
 #include "Engine/Object/PlaneObject.hpp"
 #include "Engine/Object/SphereObject.hpp"
+#include "Engine/Sampler/BlueNoiseSampler.hpp"
+#include "Engine/Sampler/SobolSampler.hpp"
 #include "Engine/Texture/CheckerboardTexture.hpp"
 #include "Engine/Texture/ImageTexture.hpp"
 #include "Engine/Texture/SolidTexture.hpp"
 
-#include <SFML/Graphics.hpp>
-
 #include <OBJ_Loader.h>
 
 #include <fkYAML/node.hpp>
@@ -23,9 +24,11 @@
 #include <cstddef>
 #include <cstdint>
 #include <fstream>
+#include <iterator>
 #include <numbers>
 #include <regex>
 #include <stdexcept>
+#include <utility>
 
 namespace
 {
@@ -40,6 +43,9 @@ namespace
 		return value;
 	}
 
+	constexpr uint64_t kFnvOffsetBasis = 0xCBF29CE484222325ull;
+	constexpr uint64_t kFnvPrime = 0x100000001B3ull;
+
 	double DoubleFromString(std::string str)
 	{
 		str = TrimWhitespace(str);
@@ -136,6 +142,21 @@ private:
 	std::string		m_path;
 };
 
+uint64_t SceneLoader::HashFile(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+
+	uint64_t hash = kFnvOffsetBasis;
+
+	for (auto it = std::istreambuf_iterator<char>(file); it != std::istreambuf_iterator<char>(); ++it)
+	{
+		hash ^= static_cast<uint8_t>(*it);
+		hash *= kFnvPrime;
+	}
+
+	return hash;
+}
+
 Scene SceneLoader::load(const std::string& path)
 {
 	std::ifstream config(path);
@@ -158,12 +179,29 @@ Scene SceneLoader::parseScene(const NodeHolder& node)
 	if (! node)
 		return {};
 
+	auto sequence = parseSequence(node.getChild("sequence"));
+
+	// Sequences don't need a separate main camera; default to the first frame.
+	auto camera = tryParseCamera(node.getChild("camera")).value_or(sequence.empty() ? Camera() : sequence.front());
+
+	auto background = parseTexture(node.getChild("background"));
+	auto objects = parseObjects(node.getChild("objects"));
+	auto lights = LightList(objects, background);
+	auto cache = parseRadianceCache(node.getChild("radianceCache"), objects);
+
 	return
 		{
-			.background			= parseTexture(node.getChild("background")),
-			.camera				= tryParseCamera(node.getChild("camera")).value_or(Camera()),
-			.objects			= parseObjects(node.getChild("objects")),
-			.samplesPerPixel	= std::max<uint32_t>(static_cast<uint32_t>(tryParseDouble(node.getChild("samplesPerPixel")).value_or(100)), 1)
+			.background			= std::move(background),
+			.camera				= std::move(camera),
+			.objects			= std::move(objects),
+			.lights				= std::move(lights),
+			.sequence			= std::move(sequence),
+			.samplesPerPixel	= std::max<uint32_t>(static_cast<uint32_t>(tryParseDouble(node.getChild("samplesPerPixel")).value_or(100)), 1),
+			.integrator			= tryParseIntegrator(node.getChild("integrator")).value_or(Scene::Integrator::Recursive),
+			.sampler			= parseSampler(node.getChild("sampler")),
+			.guide				= parsePathGuide(node.getChild("pathGuiding")),
+			.photons			= parsePhotonMap(node.getChild("causticPhotons")),
+			.cache				= std::move(cache),
 		};
 }
 
@@ -180,6 +218,62 @@ std::vector<std::shared_ptr<Object>> SceneLoader::parseObjects(const NodeHolder&
 	return objects;
 }
 
+std::vector<Camera> SceneLoader::parseSequence(const NodeHolder& node)
+{
+	if (! node)
+		return {};
+
+	if (const auto keyframesNode = node.getChild("keyframes"))
+		return parseSequenceKeyframes(keyframesNode);
+
+	std::vector<Camera> cameras;
+
+	const auto camerasNode = node.getChild("cameras", true);
+	for (const auto& camera : camerasNode.node())
+		cameras.push_back(*tryParseCamera(NodeHolder(camera, camerasNode.path() + "[" + std::to_string(cameras.size()) + "]")));
+
+	if (cameras.empty())
+		throw std::runtime_error("Sequence contains no cameras (" + camerasNode.path() + ")");
+
+	return cameras;
+}
+
+std::vector<Camera> SceneLoader::parseSequenceKeyframes(const NodeHolder& node)
+{
+	std::vector<std::pair<size_t, Camera>> keyframes;
+
+	for (const auto& keyframe : node.node())
+	{
+		const NodeHolder keyframeNode(keyframe, node.path() + "[" + std::to_string(keyframes.size()) + "]");
+
+		const auto frameNode	= keyframeNode.getChild("frame", true);
+		const auto frame		= static_cast<size_t>(std::max(tryParseDouble(frameNode).value_or(0), 0.0));
+
+		if (! keyframes.empty() && frame <= keyframes.back().first)
+			throw std::runtime_error("Sequence keyframes must be in increasing frame order (" + frameNode.path() + ")");
+
+		keyframes.emplace_back(frame, *tryParseCamera(keyframeNode.getChild("camera", true)));
+	}
+
+	if (keyframes.empty())
+		throw std::runtime_error("Sequence contains no keyframes (" + node.path() + ")");
+
+	// Frames before the first keyframe hold its camera; frames between two
+	// keyframes linearly interpolate between their cameras.
+	std::vector<Camera> cameras(keyframes.front().first + 1, keyframes.front().second);
+
+	for (size_t i = 1; i < keyframes.size(); i++)
+	{
+		const auto& [fromFrame, fromCamera]	= keyframes[i - 1];
+		const auto& [toFrame, toCamera]		= keyframes[i];
+
+		for (size_t frame = fromFrame + 1; frame <= toFrame; frame++)
+			cameras.push_back(Camera::Interpolate(fromCamera, toCamera, static_cast<double>(frame - fromFrame) / static_cast<double>(toFrame - fromFrame)));
+	}
+
+	return cameras;
+}
+
 std::shared_ptr<Object> SceneLoader::parseObject(const NodeHolder& node)
 {
 	const auto type = node.getChild("type", true).getValue<std::string>();
@@ -277,20 +371,34 @@ std::shared_ptr<Material> SceneLoader::parseMaterial(const NodeHolder& node)
 	if (! node)
 		return nullptr;
 
+	// Objects that describe their material identically share a single one, so that their
+	// hits are shaded together, and they're given the same material ID.
+	const std::string description = fkyaml::node::serialize(node.node());
+
+	auto cachedEntry = m_cache.materials.find(description);
+	if (cachedEntry != m_cache.materials.end())
+		return cachedEntry->second;
+
+	std::shared_ptr<Material> material;
+
 	const auto type = node.getChild("type", true).getValue<std::string>();
 
 	if (type == "Debug")
-		return parseDebugMaterial(node);
+		material = parseDebugMaterial(node);
 	else if (type == "Dielectric")
-		return parseDielectricMaterial(node);
+		material = parseDielectricMaterial(node);
 	else if (type == "Diffuse")
-		return parseDiffuseMaterial(node);
+		material = parseDiffuseMaterial(node);
 	else if (type == "Light")
-		return parseLightMaterial(node);
+		material = parseLightMaterial(node);
 	else if (type == "Reflective")
-		return parseReflectiveMaterial(node);
+		material = parseReflectiveMaterial(node);
 	else
 		throw std::runtime_error("Unknown material type '" + type + "' in scene YAML file (" + node.path() + ")");
+
+	m_cache.materials.emplace(description, material);
+
+	return material;
 }
 
 std::shared_ptr<Material> SceneLoader::parseDebugMaterial(const NodeHolder& node)
@@ -443,6 +551,75 @@ std::optional<Texture::Interpolation> SceneLoader::tryParseInterpolation(const N
 	throw std::runtime_error("Unknown interpolation type '" + value + "' in scene YAML file (" + node.path() + ")");
 }
 
+std::optional<Scene::Integrator> SceneLoader::tryParseIntegrator(const NodeHolder& node)
+{
+	if (! node)
+		return std::nullopt;
+
+	const std::string value = TrimWhitespace(node.getValue<std::string>());
+
+	static const std::unordered_map<std::string, Scene::Integrator> kKnownNames
+		{
+			{ "Recursive", Scene::Integrator::Recursive },
+			{ "Wavefront", Scene::Integrator::Wavefront },
+		};
+	if (kKnownNames.contains(value))
+		return kKnownNames.at(value);
+
+	throw std::runtime_error("Unknown integrator type '" + value + "' in scene YAML file (" + node.path() + ")");
+}
+
+std::shared_ptr<Sampler> SceneLoader::parseSampler(const NodeHolder& node)
+{
+	if (! node)
+		return nullptr;
+
+	const std::string value = TrimWhitespace(node.getValue<std::string>());
+
+	if (value == "Independent")
+		return nullptr;
+	else if (value == "Sobol")
+		return std::make_shared<SobolSampler>();
+	else if (value == "BlueNoise")
+		return std::make_shared<BlueNoiseSampler>();
+	else
+		throw std::runtime_error("Unknown sampler type '" + value + "' in scene YAML file (" + node.path() + ")");
+}
+
+std::shared_ptr<PathGuide> SceneLoader::parsePathGuide(const NodeHolder& node)
+{
+	if (! node || ! node.getValue<bool>())
+		return nullptr;
+
+	return std::make_shared<PathGuide>();
+}
+
+std::shared_ptr<PhotonMap> SceneLoader::parsePhotonMap(const NodeHolder& node)
+{
+	// The number of photons shot each pass; none turns caustic photons off.
+	const auto photonsPerPass = tryParseDouble(node);
+	if (! photonsPerPass || *photonsPerPass < 1)
+		return nullptr;
+
+	return std::make_shared<PhotonMap>(static_cast<size_t>(*photonsPerPass));
+}
+
+std::shared_ptr<RadianceCache> SceneLoader::parseRadianceCache(const NodeHolder& node, const std::vector<std::shared_ptr<Object>>& objects)
+{
+	if (! node)
+		return nullptr;
+
+	// Either true, for cells of the default size, or the number of cells across the scene.
+	if (node.node().is_boolean())
+		return node.getValue<bool>() ? std::make_shared<RadianceCache>(objects, RadianceCache::kDefaultCellsAcrossScene) : nullptr;
+
+	const auto cellsAcrossScene = tryParseDouble(node);
+	if (! cellsAcrossScene || *cellsAcrossScene <= 0)
+		return nullptr;
+
+	return std::make_shared<RadianceCache>(objects, *cellsAcrossScene);
+}
+
 std::optional<double> SceneLoader::tryParseAspectRatio(const NodeHolder& node)
 {
 	if (! node)
@@ -521,14 +698,11 @@ std::shared_ptr<ImageTexture> SceneLoader::makeImageTexture(const std::string& p
 
 	printf("Loading image '%s'\n", path.c_str());
 
-	sf::Image imageTexture;
-	if (! imageTexture.loadFromFile(path))
+	const auto image = Image::Load(path);
+	if (! image)
 		throw std::runtime_error("Failed to load image: " + path);
 
-	const auto	dimensions	= imageTexture.getSize();
-	const auto* pixels		= imageTexture.getPixelsPtr();
-
-	return std::make_shared<ImageTexture>(dimensions.x, dimensions.y, multiplier, interpolation, reinterpret_cast<const uint32_t*>(pixels));
+	return std::make_shared<ImageTexture>(image->width, image->height, multiplier, interpolation, image->pixels.data());
 }
 
 std::shared_ptr<Mesh> SceneLoader::makeObjectMesh(const std::string& path)
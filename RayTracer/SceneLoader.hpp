@@ -4,11 +4,16 @@
 #include "Engine/Material.hpp"
 #include "Engine/Mesh.hpp"
 #include "Engine/Object.hpp"
+#include "Engine/PathGuide.hpp"
+#include "Engine/PhotonMap.hpp"
+#include "Engine/RadianceCache.hpp"
+#include "Engine/Sampler.hpp"
 #include "Engine/Scene.hpp"
 #include "Engine/Texture.hpp"
 #include "Engine/Transform.hpp"
 #include "Engine/Vector.hpp"
 
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
@@ -20,6 +25,10 @@ class ImageTexture;
 class SceneLoader
 {
 public:
+	// Hash of a scene file's contents, used to check that a checkpoint or a remote
+	// worker belongs to the same scene.
+	static uint64_t							HashFile(const std::string& path);
+
 											SceneLoader() = default;
 
 	Scene									load(const std::string& path);
@@ -29,6 +38,8 @@ private:
 
 	Scene									parseScene(const NodeHolder& node);
 	std::vector<std::shared_ptr<Object>>	parseObjects(const NodeHolder& node);
+	std::vector<Camera>						parseSequence(const NodeHolder& node);
+	std::vector<Camera>						parseSequenceKeyframes(const NodeHolder& node);
 
 	std::shared_ptr<Object>					parseObject(const NodeHolder& node);
 	std::shared_ptr<Object>					parseBoxObject(const NodeHolder& node);
@@ -51,6 +62,11 @@ private:
 	std::optional<Color>					tryParseColor(const NodeHolder& node);
 	std::optional<Vector>					tryParseVector(const NodeHolder& node);
 	std::optional<Texture::Interpolation>	tryParseInterpolation(const NodeHolder& node);
+	std::optional<Scene::Integrator>		tryParseIntegrator(const NodeHolder& node);
+	std::shared_ptr<Sampler>				parseSampler(const NodeHolder& node);
+	std::shared_ptr<PathGuide>				parsePathGuide(const NodeHolder& node);
+	std::shared_ptr<PhotonMap>				parsePhotonMap(const NodeHolder& node);
+	std::shared_ptr<RadianceCache>			parseRadianceCache(const NodeHolder& node, const std::vector<std::shared_ptr<Object>>& objects);
 	std::optional<double>					tryParseAspectRatio(const NodeHolder& node);
 	std::optional<double>					tryParseDouble(const NodeHolder& node);
 	std::optional<Camera>					tryParseCamera(const NodeHolder& node);
@@ -64,6 +80,7 @@ private:
 	{
 		std::unordered_map<std::string, std::shared_ptr<Mesh>>			meshes;
 		std::unordered_map<std::string, std::shared_ptr<ImageTexture>>	imageTextures;
+		std::unordered_map<std::string, std::shared_ptr<Material>>		materials;
 	};
 
 	Cache 									m_cache;
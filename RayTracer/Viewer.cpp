@@ -2,26 +2,41 @@
 #include "SceneLoader.hpp"
 
 #include "Engine/MathUtil.hpp"
+#include "Engine/RadianceCache.hpp"
 #include "Engine/Transform.hpp"
 #include "Engine/Scene.hpp"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
 #include <ctime>
 #include <functional>
+#include <memory>
 #include <numbers>
 #include <optional>
 
 namespace
 {
 	constexpr auto kCoarsePreviewModeExitDelay = std::chrono::milliseconds(500);
+
+	constexpr int kMinRegionSize = 4;
+	constexpr uint32_t kRegionSamplesPerPixelMultiplier = 4;
 }
 
-Viewer::Viewer(size_t width, size_t height)
-	: m_renderer(width, height, std::thread::hardware_concurrency())
+Viewer::Viewer(size_t width, size_t height, size_t numRenderThreads, ThreadAffinity affinity)
+	: m_renderer(width, height, numRenderThreads, affinity)
 	, m_window(sf::VideoMode(static_cast<uint32_t>(width), static_cast<uint32_t>(height)), "Ray Tracer", sf::Style::Titlebar | sf::Style::Close)
 {
+	if (affinity != ThreadAffinity::None)
+		printf("%s", m_renderer.threadPlacement().report().c_str());
+
+	// The radiance cache is kept as the camera moves, so each render fills it further.
+	m_renderer.setKeepRadianceCache(true);
+
 	m_icon.loadFromFile("Assets/Icon.png");
 
 	m_window.setIcon(m_icon.getSize().x, m_icon.getSize().y, m_icon.getPixelsPtr());
@@ -50,6 +65,10 @@ Viewer::Viewer(size_t width, size_t height)
 	instructionsMessage += "(Z/X) Adjust Vertical FOV\n";
 	instructionsMessage += "(N/M) Adjust Aperture\n";
 	instructionsMessage += "(</>) Adjust Focus Distance\n";
+	instructionsMessage += "(Mouse Drag) Render Region\n";
+	instructionsMessage += "(Tab) Toggle Denoising\n";
+	instructionsMessage += "(C) Toggle Radiance Cache\n";
+	instructionsMessage += "(P, Shift+P) Cycle Preview Shading\n";
 
 	m_instructionsText.setFont(m_font);
 	m_instructionsText.setCharacterSize(16);
@@ -58,11 +77,22 @@ Viewer::Viewer(size_t width, size_t height)
 	m_instructionsText.setFillColor(sf::Color::White);
 	m_instructionsText.setString(instructionsMessage);
 	m_instructionsText.move(width - m_instructionsText.getGlobalBounds().width - 10, 10);
+
+	m_regionOutline.setFillColor(sf::Color::Transparent);
+	m_regionOutline.setOutlineColor(sf::Color::Yellow);
+	m_regionOutline.setOutlineThickness(1);
 }
 
 void Viewer::view(const std::string& path)
 {
-	enum class RenderType { CoarsePreview, Preview, Full };
+	enum class RenderType { CoarsePreview, Preview, Full, Region };
+
+	struct RenderRequest
+	{
+		Scene							scene;
+		RenderType						type;
+		std::optional<Renderer::Region>	region;
+	};
 
 	SceneLoader sceneLoader;
 
@@ -72,12 +102,40 @@ void Viewer::view(const std::string& path)
 	bool wasRendering = false;
 	bool infoTextUpdatePending = false;
 	bool sceneUpdatePending = false;
+	bool denoise = false;
 	uint8_t lastRenderPercent = 0;
 	std::string extraInfoMessage;
 
+	// How each type of render is shaded. Previews are shaded cheaply by default, so that they're
+	// readable straight away while the camera moves, before the full render takes over.
+	std::array<Renderer::Shading, 4> renderTypeShading =
+		{
+			Renderer::Shading::AmbientOcclusion,	// CoarsePreview
+			Renderer::Shading::DirectLighting,		// Preview
+			Renderer::Shading::Full,				// Full
+			Renderer::Shading::Full,				// Region
+		};
+
+	const auto shadingOf = [&](RenderType type) { return renderTypeShading[static_cast<size_t>(type)]; };
+
 	std::optional<Scene> scene;
 	uint32_t fullQualitySamplesPerPixel = 100;
 
+	std::optional<sf::Vector2i> regionDragStart;
+	std::optional<Renderer::Region> region;
+
+	// Mouse positions are in window pixels, which only match the render's pixels until the
+	// window is resized, so they're mapped through the view the render is drawn with.
+	const auto renderPixel = [this](const sf::Vector2i& windowPixel)
+	{
+		const sf::Vector2f coords = m_window.mapPixelToCoords(windowPixel);
+		return sf::Vector2i(static_cast<int>(std::floor(coords.x)), static_cast<int>(std::floor(coords.y)));
+	};
+
+	// The most recently requested render that hasn't been started yet. Newer requests
+	// replace it, so only the latest camera position is ever rendered.
+	std::optional<RenderRequest> pendingRenderRequest;
+
 	try
 	{
 		scene = sceneLoader.load(path);
@@ -101,6 +159,47 @@ void Viewer::view(const std::string& path)
 			{
 				m_window.close();
 			}
+			else if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Button::Left)
+			{
+				regionDragStart = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
+
+				m_regionOutline.setPosition(sf::Vector2f(renderPixel(*regionDragStart)));
+				m_regionOutline.setSize({});
+			}
+			else if (event.type == sf::Event::MouseMoved && regionDragStart)
+			{
+				const auto dragStart	= renderPixel(*regionDragStart);
+				const auto dragEnd		= renderPixel({ event.mouseMove.x, event.mouseMove.y });
+
+				m_regionOutline.setPosition(sf::Vector2f(std::min(dragStart.x, dragEnd.x), std::min(dragStart.y, dragEnd.y)));
+				m_regionOutline.setSize(sf::Vector2f(std::abs(dragEnd.x - dragStart.x), std::abs(dragEnd.y - dragStart.y)));
+			}
+			else if (event.type == sf::Event::MouseButtonReleased && event.mouseButton.button == sf::Mouse::Button::Left && regionDragStart)
+			{
+				const auto dragStart	= renderPixel(*regionDragStart);
+				const auto dragEnd		= renderPixel({ event.mouseButton.x, event.mouseButton.y });
+
+				const int x1 = std::clamp(std::min(dragStart.x, dragEnd.x), 0, static_cast<int>(m_renderer.width()));
+				const int y1 = std::clamp(std::min(dragStart.y, dragEnd.y), 0, static_cast<int>(m_renderer.height()));
+				const int x2 = std::clamp(std::max(dragStart.x, dragEnd.x), 0, static_cast<int>(m_renderer.width()));
+				const int y2 = std::clamp(std::max(dragStart.y, dragEnd.y), 0, static_cast<int>(m_renderer.height()));
+
+				regionDragStart.reset();
+
+				// Ignore tiny selections, which are most likely just stray clicks.
+				if ((x2 - x1) >= kMinRegionSize && (y2 - y1) >= kMinRegionSize)
+				{
+					region = Renderer::Region{ .x = static_cast<size_t>(x1), .y = static_cast<size_t>(y1), .width = static_cast<size_t>(x2 - x1), .height = static_cast<size_t>(y2 - y1) };
+
+					m_regionOutline.setPosition(static_cast<float>(x1), static_cast<float>(y1));
+					m_regionOutline.setSize(sf::Vector2f(static_cast<float>(x2 - x1), static_cast<float>(y2 - y1)));
+
+					m_renderer.stopRender();
+
+					nextRenderType = RenderType::Region;
+					sceneUpdatePending = true;
+				}
+			}
 			else if (event.type == sf::Event::KeyPressed)
 			{
 				switch (event.key.code)
@@ -160,6 +259,7 @@ void Viewer::view(const std::string& path)
 					case sf::Keyboard::Key::Delete:
 					{
 						m_renderer.stopRender();
+						pendingRenderRequest.reset();
 
 						if (wasRendering)
 						{
@@ -170,6 +270,68 @@ void Viewer::view(const std::string& path)
 						break;
 					}
 
+					case sf::Keyboard::Key::Tab:
+					{
+						denoise = ! denoise;
+
+						// A finished render is shown with (or without) denoising straight away,
+						// otherwise the render in progress is once it finishes.
+						if (! m_renderer.isRendering() && previousRenderType != RenderType::CoarsePreview)
+						{
+							m_renderer.updatePixels(denoise);
+							m_texture.update(reinterpret_cast<const sf::Uint8*>(m_renderer.pixels()));
+						}
+
+						extraInfoMessage = denoise ? "Denoising enabled." : "Denoising disabled.";
+						infoTextUpdatePending = true;
+						break;
+					}
+
+					case sf::Keyboard::Key::C:
+					{
+						if (! scene)
+							break;
+
+						// A new cache starts empty, and fills up as the scene is rendered; it's
+						// kept as the camera moves, until the scene is reloaded.
+						if (scene->cache)
+							scene->cache.reset();
+						else
+							scene->cache = std::make_shared<RadianceCache>(scene->objects, RadianceCache::kDefaultCellsAcrossScene);
+
+						m_renderer.stopRender();
+
+						nextRenderType = RenderType::CoarsePreview;
+						sceneUpdatePending = true;
+
+						extraInfoMessage = scene->cache ? "Radiance cache enabled." : "Radiance cache disabled.";
+						infoTextUpdatePending = true;
+						break;
+					}
+
+					case sf::Keyboard::Key::P:
+					{
+						// Cycles the shading of the coarse previews shown while the camera moves, or
+						// with shift, of the preview that follows them, from a full path trace through
+						// each of the cheap previews.
+						const RenderType previewType = event.key.shift ? RenderType::Preview : RenderType::CoarsePreview;
+
+						auto& shading = renderTypeShading[static_cast<size_t>(previewType)];
+						shading = static_cast<Renderer::Shading>((static_cast<size_t>(shading) + 1) % (static_cast<size_t>(Renderer::Shading::Normals) + 1));
+
+						if (scene)
+						{
+							m_renderer.stopRender();
+
+							nextRenderType = RenderType::CoarsePreview;
+							sceneUpdatePending = true;
+						}
+
+						extraInfoMessage = std::string(event.key.shift ? "Preview" : "Coarse preview") + " shading: " + Renderer::ShadingName(shading) + ".";
+						infoTextUpdatePending = true;
+						break;
+					}
+
 					case sf::Keyboard::Key::W:
 					case sf::Keyboard::Key::A:
 					case sf::Keyboard::Key::S:
@@ -263,28 +425,48 @@ void Viewer::view(const std::string& path)
 					scene->samplesPerPixel = 1;
 					break;
 				case RenderType::Full:
+				case RenderType::Region:
 					scene->samplesPerPixel = fullQualitySamplesPerPixel;
 					break;
 			}
 
-			// If we're moving, wait for the existing coarse preview to finish before
-			// starting the next, so the entire (coarse) preview is visible.
-			if (nextRenderType == RenderType::CoarsePreview && previousRenderType == RenderType::CoarsePreview)
-				m_renderer.waitForRenderCompletion();
+			// Any previously selected region is discarded once we start a new render of the whole frame.
+			if (nextRenderType != RenderType::Region)
+				region.reset();
+
+			pendingRenderRequest = RenderRequest{ .scene = scene.value(), .type = nextRenderType, .region = region };
+
+			// If we're moving, let the existing coarse preview finish before starting the
+			// next, so the entire (coarse) preview is visible. Anything else is abandoned
+			// straight away, which only has to wait for in-flight samples to complete.
+			if (nextRenderType != RenderType::CoarsePreview || previousRenderType != RenderType::CoarsePreview)
+				m_renderer.stopRender();
+
+			sceneUpdatePending = false;
+		}
 
-			m_renderer.setScene(scene.value());
-			m_renderer.setCoarsePreview(nextRenderType == RenderType::CoarsePreview);
+		if (pendingRenderRequest.has_value() && ! m_renderer.isRendering())
+		{
+			m_renderer.setScene(std::move(pendingRenderRequest->scene));
+			m_renderer.setCoarsePreview(pendingRenderRequest->type == RenderType::CoarsePreview);
+			m_renderer.setShading(shadingOf(pendingRenderRequest->type));
+			m_renderer.setRegion(pendingRenderRequest->region, fullQualitySamplesPerPixel * kRegionSamplesPerPixelMultiplier);
 			m_renderer.startRender();
 
 			wasRendering = true;
-			previousRenderType = nextRenderType;
+			previousRenderType = pendingRenderRequest->type;
 			lastRenderPercent = 0;
 
-			sceneUpdatePending = false;
+			pendingRenderRequest.reset();
 			infoTextUpdatePending = true;
 		}
 
 		const bool isRendering = m_renderer.isRendering();
+
+		// Coarse previews leave most pixels unrendered, so only the other renders are denoised.
+		if (! isRendering && wasRendering && denoise && previousRenderType != RenderType::CoarsePreview)
+			m_renderer.updatePixels(true);
+
 		if (isRendering || wasRendering)
 			m_texture.update(reinterpret_cast<const sf::Uint8*>(m_renderer.pixels()));
 
@@ -314,6 +496,7 @@ void Viewer::view(const std::string& path)
 					break;
 
 				case RenderType::Full:
+				case RenderType::Region:
 					break;
 			}
 
@@ -340,9 +523,26 @@ void Viewer::view(const std::string& path)
 				infoMessage += "Focus Distance:  " + std::to_string(scene->camera.focusDistance()) + "\n";
 
 				if (isRendering)
-					infoMessage += std::string("Rendering In Progress (" + std::string(previousRenderType != RenderType::Full ? "Preview" : "Full") + " - " + std::to_string(m_renderer.renderPercentage()) + "%, " + std::to_string(scene->samplesPerPixel) + " samples/pixel)");
+				{
+					std::string renderTypeName = "Preview, " + Renderer::ShadingName(shadingOf(previousRenderType));
+					uint32_t samplesPerPixel = scene->samplesPerPixel;
+
+					if (previousRenderType == RenderType::Full)
+					{
+						renderTypeName = "Full";
+					}
+					else if (previousRenderType == RenderType::Region)
+					{
+						renderTypeName = "Region";
+						samplesPerPixel = fullQualitySamplesPerPixel * kRegionSamplesPerPixelMultiplier;
+					}
+
+					infoMessage += std::string("Rendering In Progress (" + renderTypeName + " - " + std::to_string(m_renderer.renderPercentage()) + "%, " + std::to_string(samplesPerPixel) + " samples/pixel)");
+				}
 				else
-					infoMessage += std::string("Rendering Completed (") + std::to_string(m_renderer.renderTime().count()) + " ms)";
+				{
+					infoMessage += std::string("Rendering Completed (") + std::to_string(m_renderer.renderTime().count()) + " ms, " + std::to_string(m_renderer.renderedSamplesPerPixel()) + " samples/pixel)";
+				}
 			}
 
 			if (! extraInfoMessage.empty())
@@ -357,6 +557,8 @@ void Viewer::view(const std::string& path)
 		}
 
 		m_window.draw(m_sprite);
+		if (regionDragStart || region)
+			m_window.draw(m_regionOutline);
 		m_window.draw(m_instructionsText);
 		m_window.draw(m_infoText);
 		m_window.display();
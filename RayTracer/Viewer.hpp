@@ -2,6 +2,7 @@
 
 #include "Engine/Matrix.hpp"
 #include "Engine/Renderer.hpp"
+#include "Engine/ThreadPlacement.hpp"
 #include "Engine/Vector.hpp"
 
 #include <string>
@@ -11,7 +12,7 @@
 class Viewer
 {
 public:
-						Viewer(size_t width, size_t height);
+						Viewer(size_t width, size_t height, size_t numRenderThreads, ThreadAffinity affinity);
 
 	void				view(const std::string& path);
 
@@ -25,4 +26,5 @@ private:
 	sf::Font			m_font;
 	sf::Text			m_instructionsText;
 	sf::Text			m_infoText;
+	sf::RectangleShape	m_regionOutline;
 };